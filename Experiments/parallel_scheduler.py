@@ -0,0 +1,295 @@
+#!/usr/bin/env python3
+"""
+Parallel Experiment Scheduler
+-----------------------------
+Runs the compiler x benchmark x repetition campaign of RunnerConfig.py
+concurrently on disjoint, pinned CPU groups instead of one run at a time.
+
+Each socket's physical cores are split into --groups-per-socket groups
+(SMT siblings stay together). Every group executes one run at a time, pinned
+with numactl (CPU and memory binding to the socket's NUMA node) or, when
+numactl is missing, with taskset. Energy is read from the RAPL
+package domain of the group's socket around each run, so with one group per
+socket the reading belongs to that run alone; with more groups per socket the
+socket energy is split evenly (energy_split "even 1/N"), which is an estimate
+and not an attribution, and the kernel energy columns are left empty.
+
+energibridge measures the whole machine and cannot attribute energy to
+concurrent runs, so it is not used here.
+
+Usage:
+    python parallel_scheduler.py [--groups-per-socket 1] [--repetitions 20]
+                                 [--cooldown-ms 1000] [--reserve-cpu 0]
+"""
+import argparse
+import csv
+import datetime
+import glob
+import json
+import os
+import queue
+import random
+import shutil
+import subprocess
+import threading
+import time
+from pathlib import Path
+
+ROOT_DIR = Path(os.path.dirname(os.path.realpath(__file__)))
+
+# Same factors as RunnerConfig.create_run_table_model
+COMPILERS = ["pure_python", "cython", "swig", "native"]
+BENCHMARKS = ["bfs", "convex", "dense_matrix", "fft", "json_bench", "k_means", "quick_sort", "regex", "sieve", "nbody"]
+
+# Runs that time different work than the other compilers (see RunnerConfig.not_comparable)
+NOT_COMPARABLE = {("native", "json_bench")}
+
+# Kernel-window energy of a package shared with other running groups
+KERNEL_ENERGY_COLUMNS = ["kernel_energy_j", "kernel_energy_per_call_j", "kernel_dram_energy_j"]
+
+KERNEL_METRIC_COLUMNS = [
+    "cycles", "instructions", "ipc", "l1d_misses", "llc_misses", "branch_misses",
+    "kernel_energy_j", "kernel_energy_per_call_j", "kernel_dram_energy_j",
+    "kernel_allocations_per_call", "kernel_alloc_bytes_per_call", "kernel_peak_alloc_bytes",
+]
+
+
+def _read(path, default=None):
+    try:
+        with open(path) as f:
+            return f.read().strip()
+    except OSError:
+        return default
+
+
+# ------------------ Topology ------------------
+
+def cpu_topology(cpus):
+    """Map socket -> {core_id: [cpus]} for the given logical CPUs."""
+    sockets = {}
+    for cpu in cpus:
+        base = f"/sys/devices/system/cpu/cpu{cpu}/topology"
+        socket_id = int(_read(f"{base}/physical_package_id", "0"))
+        core_id = int(_read(f"{base}/core_id", str(cpu)))
+        sockets.setdefault(socket_id, {}).setdefault(core_id, []).append(cpu)
+    return sockets
+
+
+def numa_node(cpu):
+    nodes = glob.glob(f"/sys/devices/system/cpu/cpu{cpu}/node*")
+    return int(os.path.basename(nodes[0])[4:]) if nodes else None
+
+
+class CpuGroup:
+    def __init__(self, index, socket_id, cpus, share):
+        self.index = index
+        self.socket_id = socket_id
+        self.cpus = cpus
+        self.share = share          # number of groups on this socket
+        self.node = numa_node(cpus[0])
+
+    def cpu_list(self):
+        return ",".join(str(c) for c in self.cpus)
+
+    def __repr__(self):
+        return f"group{self.index}(socket={self.socket_id}, cpus={self.cpu_list()})"
+
+
+def make_groups(groups_per_socket, reserved):
+    cpus = sorted(c for c in os.sched_getaffinity(0) if c not in reserved)
+    groups = []
+    for socket_id, cores in sorted(cpu_topology(cpus).items()):
+        core_ids = sorted(cores)
+        count = max(1, min(groups_per_socket, len(core_ids)))
+        for g in range(count):
+            # Contiguous slices of physical cores, siblings included
+            chunk = core_ids[g * len(core_ids) // count:(g + 1) * len(core_ids) // count]
+            group_cpus = sorted(c for core in chunk for c in cores[core])
+            groups.append(CpuGroup(len(groups), socket_id, group_cpus, count))
+    return groups
+
+
+# ------------------ RAPL ------------------
+
+class SocketEnergy:
+    """Package energy of one socket from /sys/class/powercap, in joules."""
+
+    def __init__(self, socket_id):
+        self.path = None
+        self.max_range = 0
+        for zone in glob.glob("/sys/class/powercap/intel-rapl:*"):
+            if os.path.basename(zone).count(":") == 1 and _read(f"{zone}/name") == f"package-{socket_id}":
+                self.path = f"{zone}/energy_uj"
+                self.max_range = int(_read(f"{zone}/max_energy_range_uj", "0"))
+        if self.path and _read(self.path) is None:
+            self.path = None    # not readable without root
+
+    def read(self):
+        return int(_read(self.path)) if self.path else None
+
+    def delta_j(self, start, end):
+        if start is None or end is None:
+            return None
+        if end < start:
+            if not self.max_range:
+                return None         # wrapped with an unknown range
+            end += self.max_range + 1     # counter wrapped after max_range
+        return (end - start) / 1e6
+
+
+# ------------------ Scheduling ------------------
+
+def native_driver(benchmark):
+    return ROOT_DIR / "runner" / "native" / "build" / "drivers" / benchmark
+
+
+def benchmark_command(compiler, benchmark):
+    if compiler == "native":
+        return [str(native_driver(benchmark))]
+    if compiler == "pure_python":
+        script = ROOT_DIR / "runner" / compiler / f"{benchmark}.py"
+    else:
+        script = ROOT_DIR / "runner" / compiler / benchmark / "main.py"
+    return ["python3", str(script)]
+
+
+def pinned_command(group, cmd):
+    if shutil.which("numactl") and group.node is not None:
+        return ["numactl", f"--physcpubind={group.cpu_list()}", f"--membind={group.node}"] + cmd
+    if shutil.which("taskset"):
+        return ["taskset", "-c", group.cpu_list()] + cmd
+    return cmd
+
+
+def run_job(job, group, energy, run_dir):
+    run_dir.mkdir(parents=True, exist_ok=True)
+    base_cmd = benchmark_command(job["_compiler"], job["_benchmark"])
+    cmd = pinned_command(group, base_cmd)
+    # The kernel metrics read only the RAPL domains of the group's socket
+    env = dict(os.environ, KERNEL_METRICS_OUT=str(run_dir / "kernel_metrics.json"),
+               KERNEL_METRICS_RAPL_PACKAGE=str(group.socket_id))
+
+    # Last resort without numactl or taskset: set the affinity in the child
+    preexec = (lambda: os.sched_setaffinity(0, group.cpus)) if cmd is base_cmd else None
+
+    with open(run_dir / "stdout.log", "w") as log:
+        start_uj = energy.read()
+        start = time.perf_counter()
+        proc = subprocess.run(cmd, stdout=log, stderr=subprocess.STDOUT, env=env, preexec_fn=preexec)
+        elapsed = time.perf_counter() - start
+        end_uj = energy.read()
+
+    socket_j = energy.delta_j(start_uj, end_uj)
+    row = dict(job)
+    row.update({
+        "__done": "DONE" if proc.returncode == 0 else "FAILED",
+        "cpu_group": group.cpu_list(),
+        "socket": group.socket_id,
+        "execution_time (s)": round(elapsed, 3),
+        "socket_energy (J)": round(socket_j, 3) if socket_j is not None else None,
+        # The socket energy divided evenly between its groups: not an attribution
+        # to this run unless the group has the socket to itself
+        "energy_consumption (J)": round(socket_j / group.share, 3) if socket_j is not None else None,
+        "energy_split": "socket" if group.share == 1 else f"even 1/{group.share}",
+        "comparable": (job["_compiler"], job["_benchmark"]) not in NOT_COMPARABLE,
+    })
+
+    metrics_path = run_dir / "kernel_metrics.json"
+    metrics = {}
+    if metrics_path.exists():
+        with open(metrics_path) as f:
+            metrics = json.load(f)
+    for column in KERNEL_METRIC_COLUMNS:
+        row[column] = metrics.get(column)
+    if group.share > 1:
+        # The other groups on the socket ran during the kernel calls too
+        for column in KERNEL_ENERGY_COLUMNS:
+            row[column] = None
+    return row
+
+
+def build_jobs(compilers, benchmarks, repetitions, shuffle):
+    jobs = []
+    run = 0
+    for compiler in compilers:
+        for benchmark in benchmarks:
+            for rep in range(repetitions):
+                jobs.append({"__run_id": f"run_{run}_repetition_{rep}", "_compiler": compiler, "_benchmark": benchmark})
+            run += 1
+    if shuffle:
+        random.shuffle(jobs)
+    return jobs
+
+
+def schedule(jobs, groups, out_dir, cooldown_s):
+    pending = queue.Queue()
+    for job in jobs:
+        pending.put(job)
+
+    rows = []
+    lock = threading.Lock()
+    energies = {g.socket_id: SocketEnergy(g.socket_id) for g in groups}
+
+    def slot(group):
+        while True:
+            try:
+                job = pending.get_nowait()
+            except queue.Empty:
+                return
+            row = run_job(job, group, energies[group.socket_id], out_dir / job["__run_id"])
+            with lock:
+                rows.append(row)
+                print(f"[{len(rows)}/{len(jobs)}] {group} {job['_compiler']}/{job['_benchmark']} "
+                      f"{row['execution_time (s)']}s {row['energy_consumption (J)']} J", flush=True)
+            time.sleep(cooldown_s)
+
+    threads = [threading.Thread(target=slot, args=(g,)) for g in groups]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the experiment on disjoint pinned CPU groups in parallel.")
+    parser.add_argument("--groups-per-socket", type=int, default=1, help="Concurrent runs per socket")
+    parser.add_argument("--repetitions", type=int, default=20)
+    parser.add_argument("--cooldown-ms", type=int, default=1000, help="Pause between runs of one group")
+    parser.add_argument("--reserve-cpu", type=int, action="append", default=[], help="CPU kept free for the scheduler (repeatable)")
+    parser.add_argument("--compilers", nargs="+", default=COMPILERS)
+    parser.add_argument("--benchmarks", nargs="+", default=BENCHMARKS)
+    parser.add_argument("--no-shuffle", action="store_true")
+    args = parser.parse_args()
+
+    if "native" in args.compilers:
+        missing = [b for b in args.benchmarks if not native_driver(b).exists()]
+        if missing:
+            parser.error(f"native drivers not built: {', '.join(missing)} "
+                         f"(run make -C {ROOT_DIR / 'runner' / 'native'} drivers)")
+
+    groups = make_groups(args.groups_per_socket, set(args.reserve_cpu))
+    if not groups:
+        parser.error("no CPUs left after reserving")
+    for group in groups:
+        print(group)
+
+    name = "GreenLab_Compiler_Experiment_Parallel" + str(datetime.datetime.now().timestamp())
+    out_dir = ROOT_DIR / "experiments" / name
+    out_dir.mkdir(parents=True, exist_ok=True)
+
+    jobs = build_jobs(args.compilers, args.benchmarks, args.repetitions, not args.no_shuffle)
+    start = time.perf_counter()
+    rows = schedule(jobs, groups, out_dir, args.cooldown_ms / 1000)
+    print(f"Campaign finished in {time.perf_counter() - start:.1f}s using {len(groups)} CPU groups")
+
+    fieldnames = ["__run_id", "__done", "_compiler", "_benchmark", "cpu_group", "socket",
+                  "execution_time (s)", "socket_energy (J)", "energy_consumption (J)", "energy_split", "comparable"] + KERNEL_METRIC_COLUMNS
+    with open(out_dir / "run_table.csv", "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=fieldnames)
+        writer.writeheader()
+        writer.writerows(sorted(rows, key=lambda r: r["__run_id"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -22,13 +22,15 @@ def create_sparse_graph_cy(int V, int E, bint directed=False):
     Returns:
         dict: Adjacency list representation {node: [neighbors]}
     """
-    cdef int max_edges, u, v
+    cdef long long max_edges
+    cdef int u, v
     cdef tuple edge
     
     if V <= 0:
         return {}
     
-    max_edges = V * (V - 1) // 2
+    # In 64 bits: V * (V - 1) overflows an int from V = 46342
+    max_edges = <long long>V * (V - 1) // 2
     if E > max_edges:
         E = max_edges
     
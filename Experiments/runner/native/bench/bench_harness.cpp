@@ -0,0 +1,474 @@
+// bench_harness.cpp
+#include "bench_harness.h"
+#include "build_flags.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+typedef std::chrono::steady_clock Clock;
+
+static std::vector<BenchmarkDef>& registry() {
+    static std::vector<BenchmarkDef> benchmarks;
+    return benchmarks;
+}
+
+void register_benchmark(const std::string& name, const std::vector<long>& sizes,
+                        KernelSetup setup, ItemCount items) {
+    BenchmarkDef def;
+    def.name = name;
+    def.sizes = sizes;
+    def.setup = setup;
+    def.items = items;
+    registry().push_back(def);
+}
+
+void set_work_model(const std::string& name, WorkCount flops, WorkCount bytes) {
+    std::vector<BenchmarkDef>& benchmarks = registry();
+    for (size_t b = 0; b < benchmarks.size(); b++) {
+        if (benchmarks[b].name == name) {
+            benchmarks[b].flops = flops;
+            benchmarks[b].bytes = bytes;
+        }
+    }
+}
+
+const std::vector<BenchmarkDef>& registered_benchmarks() {
+    return registry();
+}
+
+const char* cache_mode_name(CacheMode mode) {
+    switch (mode) {
+    case CACHE_WARM:
+        return "warm";
+    case CACHE_COLD:
+        return "cold";
+    default:
+        return "steady";
+    }
+}
+
+static double elapsed_ns(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// Time `iterations` back-to-back calls and return the per-call time
+static double time_batch(const KernelRun& run, long iterations) {
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; i++) {
+        run();
+    }
+    Clock::time_point end = Clock::now();
+    return elapsed_ns(start, end) / iterations;
+}
+
+// Find how many calls are needed for one sample to last at least min_time_s
+static long calibrate_iterations(const KernelRun& run, double min_time_s) {
+    if (min_time_s <= 0.0) {
+        return 1;
+    }
+
+    double target_ns = min_time_s * 1e9;
+    long iterations = 1;
+    while (true) {
+        double total_ns = time_batch(run, iterations) * iterations;
+        if (total_ns >= target_ns || iterations >= (1L << 30)) {
+            break;
+        }
+        // Grow towards the target, but never more than 10x per step
+        double factor = total_ns > 0.0 ? (target_ns * 1.2) / total_ns : 10.0;
+        factor = std::min(10.0, std::max(2.0, factor));
+        iterations = static_cast<long>(std::ceil(iterations * factor));
+    }
+    return iterations;
+}
+
+static void compute_stats(BenchResult& result) {
+    std::vector<double> sorted = result.samples_ns;
+    std::sort(sorted.begin(), sorted.end());
+    size_t n = sorted.size();
+
+    result.min_ns = result.max_ns = result.mean_ns = result.median_ns = result.stddev_ns = 0.0;
+    if (n == 0) {
+        return;
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += sorted[i];
+    }
+    double mean = sum / n;
+
+    double sq = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double diff = sorted[i] - mean;
+        sq += diff * diff;
+    }
+
+    result.min_ns = sorted.front();
+    result.max_ns = sorted.back();
+    result.mean_ns = mean;
+    result.median_ns = (n % 2) ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    result.stddev_ns = n > 1 ? std::sqrt(sq / (n - 1)) : 0.0;
+}
+
+BenchResult run_benchmark(const BenchmarkDef& def, long size, const BenchOptions& options,
+                          CacheMode mode) {
+    BenchResult result;
+    result.name = def.name;
+    result.size = size;
+    result.cache_mode = mode;
+    result.items_per_call = def.items ? def.items(size) : static_cast<double>(size);
+    result.flops_per_call = def.flops ? def.flops(size) : -1.0;
+    result.bytes_per_call = def.bytes ? def.bytes(size) : -1.0;
+
+    long long start_ns = now_ns();
+
+    // Data generation happens here, outside of any timed region
+    KernelRun run;
+    {
+        TraceSpan span("harness", "setup");
+        run = def.setup(size);
+    }
+
+    {
+        TraceSpan span("harness", "warmup");
+        for (int i = 0; i < options.warmup; i++) {
+            run();
+        }
+    }
+
+    // Warm and cold samples are single calls, each prepared outside the timed region
+    if (mode == CACHE_STEADY) {
+        TraceSpan span("harness", "calibrate");
+        result.iterations = calibrate_iterations(run, options.min_time_s);
+    } else {
+        result.iterations = 1;
+    }
+    CacheFlusher* flusher = mode == CACHE_COLD ? new CacheFlusher() : NULL;
+
+    // Counters are opened only on request; the syscalls stay outside the timed batch
+    PerfCounters* counters = options.perf_counters ? new PerfCounters() : NULL;
+    RaplEnergy* energy = options.rapl_energy ? new RaplEnergy() : NULL;
+    AllocationTracker* heap = options.allocations ? new AllocationTracker() : NULL;
+
+    // With a CI target, repetitions is the minimum and the controller decides when to stop
+    RepetitionController* controller = NULL;
+    if (options.target_ci > 0.0) {
+        controller = new RepetitionController(options.target_ci, options.repetitions,
+                                              options.max_repetitions, options.max_time_s);
+    }
+
+    result.samples_ns.reserve(options.repetitions);
+    for (int r = 0; controller || r < options.repetitions; r++) {
+        if (flusher) {
+            TraceSpan span("harness", "flush");
+            flusher->flush();
+        } else if (mode == CACHE_WARM) {
+            run();
+        }
+        if (heap) {
+            heap->start();
+        }
+        if (counters) {
+            counters->start();
+        }
+        if (energy) {
+            energy->start();
+        }
+        {
+            TraceSpan span("harness", "sample");
+            result.samples_ns.push_back(time_batch(run, result.iterations));
+        }
+        if (energy) {
+            EnergyReading reading = energy->stop();
+            result.energy.accumulate(reading);
+            if (reading.package_j >= 0) {
+                result.energy_samples_j.push_back(reading.package_j / result.iterations);
+            }
+        }
+        if (counters) {
+            result.counters.accumulate(counters->stop());
+        }
+        if (heap) {
+            result.allocations.accumulate(heap->stop());
+        }
+        if (controller && !controller->add(result.samples_ns.back())) {
+            break;
+        }
+    }
+    delete heap;
+    delete energy;
+    delete counters;
+    delete flusher;
+
+    compute_stats(result);
+    MedianInterval ci = bootstrap_median_ci(result.samples_ns);
+    result.ci_low_ns = ci.low;
+    result.ci_high_ns = ci.high;
+    result.stop_reason = controller ? controller->stop_reason() : "fixed";
+    delete controller;
+
+    std::ostringstream label;
+    label << def.name << " size=" << size;
+    trace_record("benchmark", label.str(), start_ns, now_ns());
+    return result;
+}
+
+std::vector<BenchResult> run_all(const BenchOptions& options) {
+    std::vector<BenchResult> results;
+    const std::vector<BenchmarkDef>& benchmarks = registered_benchmarks();
+
+    for (size_t b = 0; b < benchmarks.size(); b++) {
+        const BenchmarkDef& def = benchmarks[b];
+        if (!options.filter.empty() && def.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        const std::vector<long>& sizes = options.sizes.empty() ? def.sizes : options.sizes;
+        for (size_t s = 0; s < sizes.size(); s++) {
+            for (size_t m = 0; m < options.cache_modes.size(); m++) {
+                results.push_back(run_benchmark(def, sizes[s], options, options.cache_modes[m]));
+                // Keep stdout clean when the JSON report is written there
+                print_results(std::vector<BenchResult>(1, results.back()), options,
+                              options.json_path == "-" ? stderr : stdout);
+            }
+        }
+    }
+
+    return results;
+}
+
+// Where one result sits under the machine roofline
+struct RooflinePoint {
+    double gflops;
+    double intensity;           // flop per byte of compulsory traffic
+    double attainable_gflops;
+    const char* bound;          // "memory" left of the ridge point, else "compute"
+};
+
+static bool roofline_point(const BenchResult& r, const BenchOptions& options, RooflinePoint& point) {
+    if (!options.roofline || !options.machine.measured() || r.flops_per_call <= 0.0 ||
+        r.bytes_per_call <= 0.0 || r.median_ns <= 0.0) {
+        return false;
+    }
+    point.gflops = r.flops_per_call / r.median_ns;
+    point.intensity = r.flops_per_call / r.bytes_per_call;
+    point.attainable_gflops = options.machine.attainable_gflops(point.intensity);
+    point.bound = point.intensity < options.machine.ridge_point() ? "memory" : "compute";
+    return true;
+}
+
+void print_results(const std::vector<BenchResult>& results, const BenchOptions& options, FILE* out) {
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        double items_per_s = r.median_ns > 0.0 ? r.items_per_call / (r.median_ns * 1e-9) : 0.0;
+        double ci_pct = r.median_ns > 0.0 ? 100.0 * (r.ci_high_ns - r.ci_low_ns) / r.median_ns : 0.0;
+        std::string name = r.name;
+        if (r.cache_mode != CACHE_STEADY) {
+            name += std::string(" (") + cache_mode_name(r.cache_mode) + ")";
+        }
+        std::fprintf(out, "%-24s size=%-9ld iters=%-6ld reps=%-5zu median=%12.3f us  ci=%6.2f%%  "
+                     "mean=%12.3f us  stddev=%10.3f us  min=%12.3f us  %10.3f Mitems/s\n",
+                     name.c_str(), r.size, r.iterations, r.samples_ns.size(),
+                     r.median_ns / 1e3, ci_pct, r.mean_ns / 1e3, r.stddev_ns / 1e3, r.min_ns / 1e3,
+                     items_per_s / 1e6);
+        if (r.allocations.allocations >= 0) {
+            double calls = static_cast<double>(r.iterations) * r.samples_ns.size();
+            std::fprintf(out, "%-24s allocs/call=%.1f  bytes/call=%.0f  peak=%lld B\n", "",
+                         r.allocations.allocations / calls, r.allocations.bytes / calls,
+                         r.allocations.peak_bytes);
+        }
+        RooflinePoint point;
+        if (roofline_point(r, options, point)) {
+            std::fprintf(out, "%-24s GFLOP/s=%.3f  intensity=%.3f flop/B  roof=%.3f GFLOP/s (%s-bound, %.1f%% of roof)\n",
+                         "", point.gflops, point.intensity, point.attainable_gflops, point.bound,
+                         100.0 * point.gflops / point.attainable_gflops);
+        }
+    }
+    std::fflush(out);
+}
+
+static std::string json_escape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size(); i++) {
+        char c = s[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// Per-call counter value, or null when the event was not collected
+static std::string per_call(double total, double calls) {
+    if (total < 0 || calls <= 0.0) {
+        return "null";
+    }
+    std::ostringstream ss;
+    ss.precision(12);
+    ss << total / calls;
+    return ss.str();
+}
+
+static void write_json_stream(std::ostream& os, const std::vector<BenchResult>& results,
+                              const BenchOptions& options) {
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+
+    char date[64];
+    std::time_t now = std::time(NULL);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os.precision(12);
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"date\": \"" << date << "\",\n";
+    os << "    \"host_name\": \"" << json_escape(host) << "\",\n";
+    os << "    \"num_cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << ",\n";
+    os << "    \"compiler\": \"" << json_escape(__VERSION__) << "\",\n";
+    os << "    \"build_flags\": \"" << json_escape(KERNEL_BENCH_BUILD_FLAGS) << "\",\n";
+    os << "    \"warmup\": " << options.warmup << ",\n";
+    os << "    \"repetitions\": " << options.repetitions << ",\n";
+    os << "    \"min_time_s\": " << options.min_time_s << ",\n";
+    os << "    \"target_ci\": " << options.target_ci;
+    if (options.roofline && options.machine.measured()) {
+        os << ",\n";
+        os << "    \"roofline\": {\n";
+        os << "      \"peak_gflops\": " << options.machine.peak_gflops << ",\n";
+        os << "      \"bandwidth_gbs\": " << options.machine.bandwidth_gbs << ",\n";
+        os << "      \"ridge_flop_per_byte\": " << options.machine.ridge_point() << "\n";
+        os << "    }";
+    }
+    os << "\n";
+    os << "  },\n";
+    os << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        double items_per_s = r.median_ns > 0.0 ? r.items_per_call / (r.median_ns * 1e-9) : 0.0;
+
+        os << (i ? ",\n" : "\n");
+        os << "    {\n";
+        os << "      \"name\": \"" << json_escape(r.name) << "\",\n";
+        os << "      \"size\": " << r.size << ",\n";
+        os << "      \"cache_mode\": \"" << cache_mode_name(r.cache_mode) << "\",\n";
+        os << "      \"iterations\": " << r.iterations << ",\n";
+        os << "      \"repetitions\": " << r.samples_ns.size() << ",\n";
+        os << "      \"time_unit\": \"ns\",\n";
+        os << "      \"min\": " << r.min_ns << ",\n";
+        os << "      \"max\": " << r.max_ns << ",\n";
+        os << "      \"mean\": " << r.mean_ns << ",\n";
+        os << "      \"median\": " << r.median_ns << ",\n";
+        os << "      \"stddev\": " << r.stddev_ns << ",\n";
+        os << "      \"median_ci\": [" << r.ci_low_ns << ", " << r.ci_high_ns << "],\n";
+        os << "      \"stop_reason\": \"" << r.stop_reason << "\",\n";
+        os << "      \"items_per_second\": " << items_per_s << ",\n";
+        if (options.perf_counters) {
+            const PerfSample& c = r.counters;
+            double calls = static_cast<double>(r.iterations) * r.samples_ns.size();
+            os << "      \"counters\": {\n";
+            os << "        \"cycles\": " << per_call(c.cycles, calls) << ",\n";
+            os << "        \"instructions\": " << per_call(c.instructions, calls) << ",\n";
+            os << "        \"ipc\": ";
+            if (c.cycles > 0) {
+                os << c.ipc();
+            } else {
+                os << "null";
+            }
+            os << ",\n";
+            os << "        \"l1d_misses\": " << per_call(c.l1d_misses, calls) << ",\n";
+            os << "        \"llc_misses\": " << per_call(c.llc_misses, calls) << ",\n";
+            os << "        \"branch_misses\": " << per_call(c.branch_misses, calls) << "\n";
+            os << "      },\n";
+        }
+        if (options.rapl_energy) {
+            const EnergyReading& e = r.energy;
+            double calls = static_cast<double>(r.iterations) * r.samples_ns.size();
+            os << "      \"energy_j\": {\n";
+            os << "        \"package\": " << per_call(e.package_j, calls) << ",\n";
+            os << "        \"core\": " << per_call(e.core_j, calls) << ",\n";
+            os << "        \"uncore\": " << per_call(e.uncore_j, calls) << ",\n";
+            os << "        \"dram\": " << per_call(e.dram_j, calls) << "\n";
+            os << "      },\n";
+            os << "      \"energy_samples\": [";
+            for (size_t s = 0; s < r.energy_samples_j.size(); s++) {
+                os << (s ? ", " : "") << r.energy_samples_j[s];
+            }
+            os << "],\n";
+        }
+        RooflinePoint point;
+        if (roofline_point(r, options, point)) {
+            os << "      \"roofline\": {\n";
+            os << "        \"flops\": " << r.flops_per_call << ",\n";
+            os << "        \"bytes\": " << r.bytes_per_call << ",\n";
+            os << "        \"gflops\": " << point.gflops << ",\n";
+            os << "        \"intensity\": " << point.intensity << ",\n";
+            os << "        \"attainable_gflops\": " << point.attainable_gflops << ",\n";
+            os << "        \"bound\": \"" << point.bound << "\",\n";
+            // Intensity against the measured last-level cache traffic, with --perf
+            os << "        \"llc_intensity\": ";
+            double calls = static_cast<double>(r.iterations) * r.samples_ns.size();
+            if (r.counters.llc_misses > 0) {
+                os << r.flops_per_call / (64.0 * r.counters.llc_misses / calls);
+            } else {
+                os << "null";
+            }
+            os << "\n";
+            os << "      },\n";
+        }
+        if (options.allocations) {
+            const AllocationSample& a = r.allocations;
+            double calls = static_cast<double>(r.iterations) * r.samples_ns.size();
+            os << "      \"allocations\": {\n";
+            os << "        \"allocations\": " << per_call(a.allocations, calls) << ",\n";
+            os << "        \"frees\": " << per_call(a.frees, calls) << ",\n";
+            os << "        \"bytes\": " << per_call(a.bytes, calls) << ",\n";
+            os << "        \"peak_bytes\": ";
+            if (a.peak_bytes >= 0) {
+                os << a.peak_bytes;
+            } else {
+                os << "null";
+            }
+            os << "\n";
+            os << "      },\n";
+        }
+        os << "      \"samples\": [";
+        for (size_t s = 0; s < r.samples_ns.size(); s++) {
+            os << (s ? ", " : "") << r.samples_ns[s];
+        }
+        os << "]\n";
+        os << "    }";
+    }
+
+    os << "\n  ]\n";
+    os << "}\n";
+}
+
+bool write_json(const std::vector<BenchResult>& results, const BenchOptions& options,
+                const std::string& path) {
+    if (path == "-") {
+        write_json_stream(std::cout, results, options);
+        return true;
+    }
+
+    std::ofstream file(path.c_str());
+    if (!file) {
+        return false;
+    }
+    write_json_stream(file, results, options);
+    return file.good();
+}
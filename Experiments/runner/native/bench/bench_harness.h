@@ -0,0 +1,130 @@
+// bench_harness.h
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include "allocation_tracker.h"
+#include "cache_flush.h"
+#include "latency_histogram.h"
+#include "perf_counters.h"
+#include "rapl_energy.h"
+#include "repetition_control.h"
+#include "roofline.h"
+#include "trace_spans.h"
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// A prepared kernel invocation. All input data is captured by the closure,
+// so only the kernel itself runs inside the timed region.
+typedef std::function<void()> KernelRun;
+
+// Builds the input data for one problem size and returns the timed call
+typedef std::function<KernelRun(long size)> KernelSetup;
+
+// Number of items processed by one call for a given size (for throughput)
+typedef std::function<double(long size)> ItemCount;
+
+// Floating point operations or bytes of compulsory memory traffic (inputs
+// read once, outputs written once) of one call, for the roofline report
+typedef std::function<double(long size)> WorkCount;
+
+struct BenchmarkDef {
+    std::string name;
+    std::vector<long> sizes;
+    KernelSetup setup;
+    ItemCount items;
+    WorkCount flops;            // empty for kernels without floating point work
+    WorkCount bytes;
+};
+
+// Cache state the kernel sees at the start of each timed call
+enum CacheMode {
+    CACHE_STEADY,               // back-to-back calls after warmup (batched by min_time_s)
+    CACHE_WARM,                 // one call per sample, right after an untimed call on the same input
+    CACHE_COLD                  // one call per sample, after a sweep that evicts the data caches
+};
+
+const char* cache_mode_name(CacheMode mode);
+
+struct BenchOptions {
+    int warmup;                 // untimed calls before sampling
+    int repetitions;            // number of timed samples (the minimum with target_ci)
+    double min_time_s;          // minimum duration of one sample (batches fast kernels)
+    std::string filter;         // substring match on benchmark name
+    std::vector<long> sizes;    // overrides the registered sizes when non-empty
+    std::string json_path;      // optional JSON output file ("-" for stdout)
+    std::string trace_path;     // optional Chrome trace-event JSON of the harness and kernel spans
+    bool perf_counters;         // collect hardware counters over the timed samples
+    bool rapl_energy;           // read RAPL energy around the timed samples
+    bool allocations;           // count heap allocations (needs LD_PRELOAD=liballoc_track.so)
+    double target_ci;           // stop once the median's 95% CI is this wide (relative); 0 = fixed
+    int max_repetitions;        // sample limit with target_ci
+    double max_time_s;          // time budget per benchmark and size with target_ci
+    bool roofline;              // report GFLOP/s and intensity against the machine roofline
+    size_t stream_bytes;        // size of each STREAM probe array
+    MachineRoofline machine;    // filled by measure_roofline() when roofline is set
+    std::vector<CacheMode> cache_modes;  // each benchmark and size runs once per mode
+
+    BenchOptions()
+        : warmup(1), repetitions(10), min_time_s(0.0), perf_counters(false),
+          rapl_energy(false), allocations(false), target_ci(0.0), max_repetitions(1000), max_time_s(10.0),
+          roofline(false), stream_bytes(64u << 20), cache_modes(1, CACHE_STEADY) {}
+};
+
+struct BenchResult {
+    std::string name;
+    long size;
+    CacheMode cache_mode;
+    long iterations;            // kernel calls per sample
+    std::vector<double> samples_ns;  // per-call time of each sample
+    double items_per_call;
+    PerfSample counters;        // totals over all timed calls, -1 if not collected
+    EnergyReading energy;       // totals over all timed calls, -1 if not collected
+    std::vector<double> energy_samples_j;  // per-call package energy of each sample
+    AllocationSample allocations;  // totals over all timed calls, -1 if not collected
+    double flops_per_call;      // from the work model, -1 without one
+    double bytes_per_call;
+
+    double min_ns;
+    double max_ns;
+    double mean_ns;
+    double median_ns;
+    double stddev_ns;
+
+    // Bootstrap 95% CI of the median and why sampling stopped
+    double ci_low_ns;
+    double ci_high_ns;
+    std::string stop_reason;    // "fixed", "converged", "max_samples" or "time_budget"
+};
+
+// Register a kernel benchmark; sizes are the default parameter sweep
+void register_benchmark(const std::string& name, const std::vector<long>& sizes,
+                        KernelSetup setup, ItemCount items = ItemCount());
+
+// Attach FLOP and byte counts to a registered benchmark
+void set_work_model(const std::string& name, WorkCount flops, WorkCount bytes);
+
+const std::vector<BenchmarkDef>& registered_benchmarks();
+
+// Time one benchmark at one size according to the options
+BenchResult run_benchmark(const BenchmarkDef& def, long size, const BenchOptions& options,
+                          CacheMode mode = CACHE_STEADY);
+
+// Run every registered benchmark matching the filter
+std::vector<BenchResult> run_all(const BenchOptions& options);
+
+void print_results(const std::vector<BenchResult>& results, const BenchOptions& options,
+                   FILE* out = stdout);
+
+bool write_json(const std::vector<BenchResult>& results, const BenchOptions& options,
+                const std::string& path);
+
+// Keep the compiler from discarding a kernel result
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,383 @@
+// bench_kernels.cpp
+// Registers the runner/swig kernels with the native harness. Default sizes
+// follow the problem sizes used by the corresponding main.py scripts.
+#include "bench_kernels.h"
+#include "bench_harness.h"
+#include "energy_selector.h"
+
+#include "bfs_swig.h"
+#include "conv_swig.h"
+#include "fft_swig.h"
+#include "kmeans_swig.h"
+#include "matmul_swig.h"
+#include "nbody_swig.h"
+#include "quicksort_swig.h"
+#include "regex_swig.h"
+#include "sieve_swig.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+
+// Fixed seed so every run of the harness sees the same inputs
+static std::mt19937& rng() {
+    static std::mt19937 engine(12345);
+    return engine;
+}
+
+static Vector1D random_vector(long n) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    Vector1D v(n);
+    for (long i = 0; i < n; i++) {
+        v[i] = dist(rng());
+    }
+    return v;
+}
+
+static Matrix2D random_matrix(long n) {
+    Matrix2D m(n);
+    for (long i = 0; i < n; i++) {
+        m[i] = random_vector(n);
+    }
+    return m;
+}
+
+// Same corpus as regex/main.py, scaled to size_kb kilobytes
+static std::string make_corpus(long size_kb) {
+    std::string base;
+    for (int i = 0; i < 10; i++) {
+        base += "The quick brown fox jumps over the lazy dog's fence. ";
+    }
+
+    size_t target = static_cast<size_t>(size_kb) * 1024;
+    std::string text;
+    text.reserve(target + base.size());
+    while (text.size() < target) {
+        text += base;
+    }
+    text.resize(target);
+
+    std::string out;
+    out.reserve(text.size() + text.size() / 4);
+    size_t pos = 0;
+    size_t hit;
+    while ((hit = text.find("fox", pos)) != std::string::npos) {
+        out.append(text, pos, hit - pos);
+        out += "12345.67 fox";
+        pos = hit + 3;
+    }
+    out.append(text, pos, std::string::npos);
+    out += " https://example.com/page?id=1";
+    return out;
+}
+
+static void register_bfs() {
+    // size = number of vertices, with the 2.5 edges per vertex of Test 1
+    register_benchmark("bfs", {10000, 50000}, [](long V) -> KernelRun {
+        std::shared_ptr<Graph> graph(new Graph(create_sparse_graph(V, static_cast<int>(V * 5 / 2), false)));
+        int start = static_cast<int>(rng()() % V);
+        return [graph, start]() {
+            BFSResult r = breadth_first_search(*graph, start);
+            do_not_optimize(r.first);
+        };
+    }, [](long V) { return V * 3.5; });
+
+    // Point-to-point queries on the same graphs; each call answers one of
+    // 64 fixed random vertex pairs in turn
+    register_benchmark("bfs_path", {10000, 50000}, [](long V) -> KernelRun {
+        std::shared_ptr<Graph> graph(new Graph(create_sparse_graph(V, static_cast<int>(V * 5 / 2), false)));
+        std::shared_ptr<std::vector<std::pair<int, int> > > queries(new std::vector<std::pair<int, int> >());
+        for (int q = 0; q < 64; q++) {
+            queries->push_back(std::make_pair(static_cast<int>(rng()() % V), static_cast<int>(rng()() % V)));
+        }
+        std::shared_ptr<size_t> next(new size_t(0));
+        return [graph, queries, next]() {
+            const std::pair<int, int>& query = (*queries)[(*next)++ % queries->size()];
+            std::vector<int> path = shortest_path(*graph, query.first, query.second);
+            do_not_optimize(path.data());
+        };
+    });
+
+    register_benchmark("bfs_components", {10000, 50000}, [](long V) -> KernelRun {
+        std::shared_ptr<Graph> graph(new Graph(create_sparse_graph(V, static_cast<int>(V * 5 / 2), false)));
+        return [graph]() {
+            std::vector<int> labels = connected_components(*graph);
+            do_not_optimize(labels.data());
+        };
+    }, [](long V) { return V * 3.5; });
+
+    // 3-hop neighborhoods of successive vertices, reusing the visited state
+    register_benchmark("bfs_khop", {10000, 50000}, [](long V) -> KernelRun {
+        Graph graph = create_sparse_graph(V, static_cast<int>(V * 5 / 2), false);
+        std::shared_ptr<BoundedBFS> search(new BoundedBFS(graph));
+        std::shared_ptr<int> next(new int(0));
+        return [search, next, V]() {
+            int visited = search->search((*next)++ % V, 3);
+            do_not_optimize(visited);
+        };
+    });
+}
+
+static void register_conv() {
+    register_benchmark("conv_1d", {600, 100000}, [](long n) -> KernelRun {
+        std::shared_ptr<Vector1D> data(new Vector1D(random_vector(n)));
+        std::shared_ptr<Vector1D> kernel(new Vector1D(random_vector(7)));
+        return [data, kernel]() {
+            Vector1D out = convolution_1d(*data, *kernel);
+            do_not_optimize(out.data());
+        };
+    });
+
+    // size = image side length, 5x5 kernel
+    register_benchmark("conv_2d", {250, 500}, [](long n) -> KernelRun {
+        std::shared_ptr<Matrix2D> image(new Matrix2D(random_matrix(n)));
+        std::shared_ptr<Matrix2D> kernel(new Matrix2D(random_matrix(5)));
+        return [image, kernel]() {
+            Matrix2D out = convolution_2d(*image, *kernel);
+            do_not_optimize(out.data());
+        };
+    }, [](long n) { return static_cast<double>(n) * n; });
+}
+
+// matmul_blocked with its default 64x64 tile
+static Matrix2D matmul_blocked_default(const Matrix2D& A, const Matrix2D& B) {
+    return matmul_blocked(A, B);
+}
+
+static void register_matmul() {
+    struct Variant {
+        const char* name;
+        Matrix2D (*fn)(const Matrix2D&, const Matrix2D&);
+    };
+    const Variant variants[] = {
+        {"matmul_naive", matmul_naive},
+        {"matmul_blocked", matmul_blocked_default},
+        {"matmul_transpose", matmul_transpose},
+    };
+
+    // size = N for NxN matrices; items are floating point operations
+    for (const Variant& v : variants) {
+        Matrix2D (*fn)(const Matrix2D&, const Matrix2D&) = v.fn;
+        register_benchmark(v.name, {128, 256, 512}, [fn](long n) -> KernelRun {
+            std::shared_ptr<Matrix2D> A(new Matrix2D(random_matrix(n)));
+            std::shared_ptr<Matrix2D> B(new Matrix2D(random_matrix(n)));
+            return [fn, A, B]() {
+                Matrix2D C = fn(*A, *B);
+                do_not_optimize(C.data());
+            };
+        }, [](long n) { return 2.0 * n * n * n; });
+    }
+}
+
+static void register_fft() {
+    struct Variant {
+        const char* name;
+        ComplexVector (*fn)(const ComplexVector&);
+    };
+    const Variant variants[] = {
+        {"fft_recursive", fft_cooley_tukey},
+        {"fft_iterative", fft_iterative},
+    };
+
+    for (const Variant& v : variants) {
+        ComplexVector (*fn)(const ComplexVector&) = v.fn;
+        register_benchmark(v.name, {1024, 65536}, [fn](long n) -> KernelRun {
+            Vector1D re = random_vector(n);
+            Vector1D im = random_vector(n);
+            std::shared_ptr<ComplexVector> x(new ComplexVector(n));
+            for (long i = 0; i < n; i++) {
+                (*x)[i] = Complex(re[i], im[i]);
+            }
+            return [fn, x]() {
+                ComplexVector X = fn(*x);
+                do_not_optimize(X.data());
+            };
+        }, [](long n) { return 5.0 * n * std::log2(static_cast<double>(n)); });
+    }
+}
+
+static void register_kmeans() {
+    // size = number of points, D=5 and K=10 as in Test 1
+    register_benchmark("kmeans_iteration", {20000, 100000}, [](long n) -> KernelRun {
+        std::shared_ptr<DataSet> data(new DataSet(initialize_data(static_cast<int>(n), 5)));
+        std::shared_ptr<DataSet> centroids(new DataSet(initialize_centroids(*data, 10)));
+        return [data, centroids]() {
+            DataSet next = kmeans_iteration(*data, *centroids);
+            do_not_optimize(next.data());
+        };
+    });
+}
+
+static void register_nbody() {
+    // size = number of bodies; items are pairwise interactions
+    register_benchmark("nbody_step", {500, 1500}, [](long n) -> KernelRun {
+        std::shared_ptr<BodiesVector> bodies(new BodiesVector(initialize_bodies(static_cast<int>(n))));
+        return [bodies]() {
+            BodiesVector next = nbody_step_update(*bodies, 0.01);
+            do_not_optimize(next.data());
+        };
+    }, [](long n) { return static_cast<double>(n) * (n - 1); });
+}
+
+static void register_quicksort() {
+    register_benchmark("quicksort", {50000, 150000}, [](long n) -> KernelRun {
+        std::shared_ptr<Vector1D> data(new Vector1D(random_vector(n)));
+        return [data]() {
+            std::vector<double> sorted = quicksort(*data);
+            do_not_optimize(sorted.data());
+        };
+    });
+}
+
+static void register_regex() {
+    struct Variant {
+        const char* name;
+        std::vector<std::string> (*fn)(const std::string&);
+    };
+    const Variant variants[] = {
+        {"regex_simple", simple_tokenize},
+        {"regex_fast_word", fast_word_tokenize},
+        {"regex_char", char_tokenize},
+    };
+
+    // size = text size in KB; items are input bytes
+    for (const Variant& v : variants) {
+        std::vector<std::string> (*fn)(const std::string&) = v.fn;
+        register_benchmark(v.name, {200, 800}, [fn](long kb) -> KernelRun {
+            std::shared_ptr<std::string> text(new std::string(make_corpus(kb)));
+            return [fn, text]() {
+                std::vector<std::string> tokens = fn(*text);
+                do_not_optimize(tokens.data());
+            };
+        }, [](long kb) { return kb * 1024.0; });
+    }
+}
+
+static void register_sieve() {
+    register_benchmark("sieve", {100000, 1000000}, [](long limit) -> KernelRun {
+        int n = static_cast<int>(limit);
+        return [n]() {
+            std::vector<int> primes = sieve_of_eratosthenes(n);
+            do_not_optimize(primes.data());
+        };
+    });
+}
+
+// FLOP and compulsory byte counts for the roofline report. Bytes are the
+// inputs read once plus the outputs written once (8 per double), a lower
+// bound on the real traffic; kernels without floating point work have none.
+static void register_work_models() {
+    // 7-tap 'same' convolution: one multiply-add per tap and output
+    set_work_model("conv_1d",
+                   [](long n) { return 2.0 * 7 * n; },
+                   [](long n) { return 8.0 * (2 * n + 7); });
+    set_work_model("conv_2d",
+                   [](long n) { return 2.0 * 25 * n * n; },
+                   [](long n) { return 8.0 * (2.0 * n * n + 25); });
+
+    const char* matmuls[] = {"matmul_naive", "matmul_blocked", "matmul_transpose"};
+    for (const char* name : matmuls) {
+        set_work_model(name,
+                       [](long n) { return 2.0 * n * n * n; },
+                       [](long n) { return 8.0 * 3 * n * n; });
+    }
+
+    // Conventional 5 N log2 N for a complex radix-2 FFT; 16 bytes per complex
+    const char* ffts[] = {"fft_recursive", "fft_iterative"};
+    for (const char* name : ffts) {
+        set_work_model(name,
+                       [](long n) { return 5.0 * n * std::log2(static_cast<double>(n)); },
+                       [](long n) { return 16.0 * 2 * n; });
+    }
+
+    // D=5, K=10: 3D+1 flops per point-centroid distance (sqrt counted once), D to accumulate
+    set_work_model("kmeans_iteration",
+                   [](long n) { return n * (10.0 * (3 * 5 + 1) + 5); },
+                   [](long n) { return 8.0 * (5.0 * n + 2 * 10 * 5); });
+
+    // 17 flops per pairwise interaction (sqrt and divide counted once), 8 per body update;
+    // five doubles per body in and out
+    set_work_model("nbody_step",
+                   [](long n) { return 17.0 * n * (n - 1) + 8.0 * n; },
+                   [](long n) { return 8.0 * 5 * 2 * n; });
+}
+
+void register_kernel_benchmarks() {
+    register_bfs();
+    register_conv();
+    register_matmul();
+    register_fft();
+    register_kmeans();
+    register_nbody();
+    register_quicksort();
+    register_regex();
+    register_sieve();
+    register_work_models();
+}
+
+static void add_candidate(EnergySelector& selector, const std::string& kernel,
+                          const std::string& variant, bool threaded, ThreadedSetup setup) {
+    SelectCandidate candidate;
+    candidate.kernel = kernel;
+    candidate.variant = variant;
+    candidate.threaded = threaded;
+    candidate.setup = setup;
+    selector.add_candidate(candidate);
+}
+
+void register_select_candidates(EnergySelector& selector) {
+    // size = N for NxN matrices
+    struct MatmulVariant {
+        const char* name;
+        Matrix2D (*fn)(const Matrix2D&, const Matrix2D&);
+    };
+    const MatmulVariant matmuls[] = {
+        {"naive", matmul_naive},
+        {"blocked", matmul_blocked_default},
+        {"transpose", matmul_transpose},
+    };
+    for (const MatmulVariant& v : matmuls) {
+        Matrix2D (*fn)(const Matrix2D&, const Matrix2D&) = v.fn;
+        add_candidate(selector, "matmul", v.name, false, [fn](long n, int) -> KernelRun {
+            std::shared_ptr<Matrix2D> A(new Matrix2D(random_matrix(n)));
+            std::shared_ptr<Matrix2D> B(new Matrix2D(random_matrix(n)));
+            return [fn, A, B]() {
+                Matrix2D C = fn(*A, *B);
+                do_not_optimize(C.data());
+            };
+        });
+    }
+    add_candidate(selector, "matmul", "parallel", true, [](long n, int threads) -> KernelRun {
+        std::shared_ptr<Matrix2D> A(new Matrix2D(random_matrix(n)));
+        std::shared_ptr<Matrix2D> B(new Matrix2D(random_matrix(n)));
+        return [A, B, threads]() {
+            Matrix2D C = matmul_parallel(*A, *B, threads);
+            do_not_optimize(C.data());
+        };
+    });
+
+    struct FftVariant {
+        const char* name;
+        ComplexVector (*fn)(const ComplexVector&);
+    };
+    const FftVariant ffts[] = {
+        {"recursive", fft_cooley_tukey},
+        {"iterative", fft_iterative},
+    };
+    for (const FftVariant& v : ffts) {
+        ComplexVector (*fn)(const ComplexVector&) = v.fn;
+        add_candidate(selector, "fft", v.name, false, [fn](long n, int) -> KernelRun {
+            Vector1D re = random_vector(n);
+            Vector1D im = random_vector(n);
+            std::shared_ptr<ComplexVector> x(new ComplexVector(n));
+            for (long i = 0; i < n; i++) {
+                (*x)[i] = Complex(re[i], im[i]);
+            }
+            return [fn, x]() {
+                ComplexVector X = fn(*x);
+                do_not_optimize(X.data());
+            };
+        });
+    }
+}
@@ -0,0 +1,13 @@
+// bench_kernels.h
+#ifndef BENCH_KERNELS_H
+#define BENCH_KERNELS_H
+
+class EnergySelector;
+
+// Register bfs, conv, matmul, fft, kmeans, nbody, quicksort, regex and sieve
+void register_kernel_benchmarks();
+
+// Register the alternative implementations of matmul and fft for energy_select
+void register_select_candidates(EnergySelector& selector);
+
+#endif // BENCH_KERNELS_H
@@ -0,0 +1,192 @@
+// bench_main.cpp
+// Native kernel benchmark suite: times the runner/swig kernels directly,
+// without the Python interpreter or SWIG marshalling in the loop.
+//
+// Usage:
+//     kernel_bench [--filter NAME] [--sizes N,M,...] [--warmup W]
+//                  [--repetitions R] [--min-time SECONDS] [--json FILE|-]
+//                  [--target-ci WIDTH [--max-repetitions N] [--max-time SECONDS]]
+//                  [--perf] [--energy] [--alloc] [--trace FILE]
+//                  [--roofline [--stream-mb MB]] [--cache-mode steady|warm|cold|all]
+//                  [--list]
+#include "bench_harness.h"
+#include "bench_kernels.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s [options]\n"
+                 "  --filter NAME        only run benchmarks whose name contains NAME\n"
+                 "  --sizes N,M,...      override the problem sizes of every benchmark\n"
+                 "  --warmup W           untimed calls before sampling (default 1)\n"
+                 "  --repetitions R      timed samples per size (default 10)\n"
+                 "  --min-time SECONDS   minimum duration of one sample (default 0)\n"
+                 "  --target-ci WIDTH    repeat until the median's 95%% CI is within WIDTH\n"
+                 "                       (relative, e.g. 0.02); --repetitions is then the minimum\n"
+                 "  --max-repetitions N  sample limit with --target-ci (default 1000)\n"
+                 "  --max-time SECONDS   time budget per size with --target-ci (default 10)\n"
+                 "  --json FILE          write results as JSON (\"-\" for stdout)\n"
+                 "  --perf               collect hardware counters (perf_event_open)\n"
+                 "  --energy             measure RAPL energy per call (powercap; steady mode only)\n"
+                 "  --alloc              count heap allocations per call; run with\n"
+                 "                       LD_PRELOAD=build/liballoc_track.so\n"
+                 "  --trace FILE         write a Chrome trace-event timeline of the harness\n"
+                 "                       phases and kernel spans (chrome://tracing, Perfetto)\n"
+                 "  --roofline           measure peak FLOP/s and memory bandwidth, then report\n"
+                 "                       GFLOP/s and arithmetic intensity per kernel\n"
+                 "  --stream-mb MB       size of each bandwidth probe array (default 64)\n"
+                 "  --cache-mode MODES   steady (default), warm, cold, or a comma list / all;\n"
+                 "                       warm and cold time single calls after an untimed call\n"
+                 "                       or after evicting the caches, reported separately\n"
+                 "  --list               list benchmarks and their default sizes\n",
+                 prog);
+}
+
+static bool parse_cache_modes(const std::string& arg, std::vector<CacheMode>& modes) {
+    modes.clear();
+    std::stringstream ss(arg == "all" ? "steady,warm,cold" : arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item == "steady") {
+            modes.push_back(CACHE_STEADY);
+        } else if (item == "warm") {
+            modes.push_back(CACHE_WARM);
+        } else if (item == "cold") {
+            modes.push_back(CACHE_COLD);
+        } else {
+            return false;
+        }
+    }
+    return !modes.empty();
+}
+
+static std::vector<long> parse_sizes(const std::string& arg) {
+    std::vector<long> sizes;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            sizes.push_back(std::atol(item.c_str()));
+        }
+    }
+    return sizes;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    bool list = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (std::strcmp(arg, "--filter") == 0 && has_value) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(arg, "--sizes") == 0 && has_value) {
+            options.sizes = parse_sizes(argv[++i]);
+        } else if (std::strcmp(arg, "--warmup") == 0 && has_value) {
+            options.warmup = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--repetitions") == 0 && has_value) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--min-time") == 0 && has_value) {
+            options.min_time_s = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--target-ci") == 0 && has_value) {
+            options.target_ci = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--max-repetitions") == 0 && has_value) {
+            options.max_repetitions = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--max-time") == 0 && has_value) {
+            options.max_time_s = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--json") == 0 && has_value) {
+            options.json_path = argv[++i];
+        } else if (std::strcmp(arg, "--trace") == 0 && has_value) {
+            options.trace_path = argv[++i];
+        } else if (std::strcmp(arg, "--perf") == 0) {
+            options.perf_counters = true;
+        } else if (std::strcmp(arg, "--energy") == 0) {
+            options.rapl_energy = true;
+        } else if (std::strcmp(arg, "--alloc") == 0) {
+            options.allocations = true;
+        } else if (std::strcmp(arg, "--roofline") == 0) {
+            options.roofline = true;
+        } else if (std::strcmp(arg, "--stream-mb") == 0 && has_value) {
+            options.stream_bytes = static_cast<size_t>(std::atol(argv[++i])) << 20;
+        } else if (std::strcmp(arg, "--cache-mode") == 0 && has_value) {
+            if (!parse_cache_modes(argv[++i], options.cache_modes)) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--list") == 0) {
+            list = true;
+        } else {
+            usage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    if (options.repetitions < 1) {
+        std::fprintf(stderr, "--repetitions must be at least 1\n");
+        return 1;
+    }
+    // Warm and cold samples are one call each, far below the ~1 ms RAPL update interval
+    for (size_t m = 0; m < options.cache_modes.size(); m++) {
+        if (options.rapl_energy && options.cache_modes[m] != CACHE_STEADY) {
+            std::fprintf(stderr, "--energy needs --cache-mode steady: warm and cold samples are single calls\n");
+            return 1;
+        }
+    }
+
+    register_kernel_benchmarks();
+
+    if (list) {
+        const std::vector<BenchmarkDef>& benchmarks = registered_benchmarks();
+        for (size_t b = 0; b < benchmarks.size(); b++) {
+            std::printf("%-24s", benchmarks[b].name.c_str());
+            for (size_t s = 0; s < benchmarks[b].sizes.size(); s++) {
+                std::printf(" %ld", benchmarks[b].sizes[s]);
+            }
+            std::printf("\n");
+        }
+        return 0;
+    }
+
+    if (options.roofline) {
+        options.machine = measure_roofline(options.stream_bytes);
+        // Keep stdout clean when the JSON report is written there
+        std::fprintf(options.json_path == "-" ? stderr : stdout,
+                     "Roofline: peak %.2f GFLOP/s, bandwidth %.2f GB/s, ridge point %.2f flop/B\n",
+                     options.machine.peak_gflops, options.machine.bandwidth_gbs,
+                     options.machine.ridge_point());
+    }
+
+    if (!options.trace_path.empty()) {
+        trace_thread_name("kernel_bench");
+        trace_enable(true);
+    }
+
+    std::vector<BenchResult> results = run_all(options);
+
+    if (!options.trace_path.empty()) {
+        trace_enable(false);
+        if (!trace_write_json(options.trace_path)) {
+            std::fprintf(stderr, "Failed to write %s\n", options.trace_path.c_str());
+            return 1;
+        }
+        long long dropped = trace_dropped_count();
+        if (dropped > 0) {
+            std::fprintf(stderr, "%lld early spans were overwritten; the trace keeps the latest per thread\n",
+                         dropped);
+        }
+    }
+
+    if (!options.json_path.empty() && !write_json(results, options, options.json_path)) {
+        std::fprintf(stderr, "Failed to write %s\n", options.json_path.c_str());
+        return 1;
+    }
+
+    return 0;
+}
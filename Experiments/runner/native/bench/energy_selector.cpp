@@ -0,0 +1,205 @@
+// energy_selector.cpp
+#include "energy_selector.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+// RAPL counters update about once per millisecond; shorter samples are noise
+static const double MIN_SAMPLE_S = 0.05;
+
+const char* objective_name(SelectObjective objective) {
+    return objective == MIN_EDP ? "edp" : "energy";
+}
+
+static std::string cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                return line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+        }
+    }
+    return "unknown";
+}
+
+static std::string machine_key() {
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    std::ostringstream key;
+    key << host << " / " << cpu_model() << " / " << sysconf(_SC_NPROCESSORS_ONLN) << " cpus";
+    std::string s = key.str();
+    std::replace(s.begin(), s.end(), '\t', ' ');
+    return s;
+}
+
+static std::string cache_key(const std::string& machine, const std::string& kernel, long size,
+                             const std::string& objective) {
+    std::ostringstream key;
+    key << machine << '\t' << kernel << '\t' << size << '\t' << objective;
+    return key.str();
+}
+
+static double median(std::vector<double> values) {
+    if (values.empty()) {
+        return -1.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return (n % 2) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+EnergySelector::EnergySelector(const std::string& cache_path)
+    : cache_path(cache_path), machine(machine_key()) {
+    load_cache();
+}
+
+void EnergySelector::add_candidate(const SelectCandidate& candidate) {
+    candidates.push_back(candidate);
+}
+
+std::vector<std::string> EnergySelector::kernels() const {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (std::find(names.begin(), names.end(), candidates[i].kernel) == names.end()) {
+            names.push_back(candidates[i].kernel);
+        }
+    }
+    return names;
+}
+
+const std::string& EnergySelector::error() const {
+    return error_msg;
+}
+
+// One decision per line:
+// machine  kernel  size  objective  variant  threads  time_s  energy_j
+void EnergySelector::load_cache() {
+    std::ifstream file(cache_path.c_str());
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, '\t')) {
+            fields.push_back(field);
+        }
+        if (fields.size() != 8) {
+            continue;
+        }
+        EnergySelection entry;
+        entry.kernel = fields[1];
+        entry.size = std::atol(fields[2].c_str());
+        entry.objective = fields[3];
+        entry.variant = fields[4];
+        entry.threads = std::atoi(fields[5].c_str());
+        entry.time_s = std::atof(fields[6].c_str());
+        entry.energy_j = std::atof(fields[7].c_str());
+        entry.cached = true;
+        cache[cache_key(fields[0], entry.kernel, entry.size, entry.objective)] = entry;
+    }
+}
+
+bool EnergySelector::save_cache() {
+    std::string tmp = cache_path + ".tmp";
+    std::ofstream file(tmp.c_str());
+    if (!file) {
+        return false;
+    }
+    file.precision(9);
+    for (std::map<std::string, EnergySelection>::const_iterator it = cache.begin(); it != cache.end(); ++it) {
+        const EnergySelection& e = it->second;
+        // The key already starts with machine, kernel, size and objective
+        file << it->first << '\t' << e.variant << '\t' << e.threads << '\t'
+             << e.time_s << '\t' << e.energy_j << '\n';
+    }
+    file.close();
+    return file.good() && std::rename(tmp.c_str(), cache_path.c_str()) == 0;
+}
+
+bool EnergySelector::select(const std::string& kernel, long size, SelectObjective objective,
+                            const std::vector<int>& thread_counts, const BenchOptions& options,
+                            bool refresh, EnergySelection& out) {
+    error_msg.clear();
+    std::string key = cache_key(machine, kernel, size, objective_name(objective));
+    std::map<std::string, EnergySelection>::const_iterator hit = cache.find(key);
+    if (!refresh && hit != cache.end()) {
+        out = hit->second;
+        return true;
+    }
+
+    BenchOptions profile_options = options;
+    profile_options.rapl_energy = true;
+    profile_options.min_time_s = std::max(options.min_time_s, MIN_SAMPLE_S);
+    profile_options.target_ci = 0.0;
+
+    out = EnergySelection();
+    out.kernel = kernel;
+    out.size = size;
+    out.cached = false;
+
+    bool have_energy = true;
+    for (size_t c = 0; c < candidates.size(); c++) {
+        const SelectCandidate& candidate = candidates[c];
+        if (candidate.kernel != kernel) {
+            continue;
+        }
+        std::vector<int> counts = candidate.threaded ? thread_counts : std::vector<int>(1, 1);
+        for (size_t t = 0; t < counts.size(); t++) {
+            int threads = counts[t];
+            ThreadedSetup setup = candidate.setup;
+
+            BenchmarkDef def;
+            def.name = kernel + "/" + candidate.variant;
+            def.setup = [setup, threads](long n) { return setup(n, threads); };
+            BenchResult result = run_benchmark(def, size, profile_options);
+
+            CandidateProfile profile;
+            profile.variant = candidate.variant;
+            profile.threads = threads;
+            profile.time_s = result.median_ns * 1e-9;
+            profile.energy_j = median(result.energy_samples_j);
+            have_energy = have_energy && profile.energy_j > 0.0;
+            out.profiles.push_back(profile);
+        }
+    }
+
+    if (out.profiles.empty()) {
+        error_msg = "no candidates for kernel '" + kernel + "'";
+        return false;
+    }
+
+    // Without RAPL the choice falls back to the fastest and is not cached
+    out.objective = have_energy ? objective_name(objective) : "time";
+    const CandidateProfile* best = &out.profiles[0];
+    for (size_t i = 1; i < out.profiles.size(); i++) {
+        const CandidateProfile& p = out.profiles[i];
+        double score = !have_energy ? p.time_s : objective == MIN_EDP ? p.edp() : p.energy_j;
+        double best_score = !have_energy ? best->time_s : objective == MIN_EDP ? best->edp() : best->energy_j;
+        if (score < best_score) {
+            best = &p;
+        }
+    }
+    out.variant = best->variant;
+    out.threads = best->threads;
+    out.time_s = best->time_s;
+    out.energy_j = best->energy_j;
+
+    if (have_energy) {
+        EnergySelection entry = out;
+        entry.cached = true;
+        entry.profiles.clear();
+        cache[key] = entry;
+        if (!save_cache()) {
+            error_msg = "could not write " + cache_path;
+            return false;
+        }
+    }
+    return true;
+}
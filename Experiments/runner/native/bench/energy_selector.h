@@ -0,0 +1,88 @@
+// energy_selector.h
+#ifndef ENERGY_SELECTOR_H
+#define ENERGY_SELECTOR_H
+
+#include "bench_harness.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Builds the input data for one problem size and returns the timed call,
+// run with the given number of threads (1 for single-threaded variants)
+typedef std::function<KernelRun(long size, int threads)> ThreadedSetup;
+
+// One implementation of a kernel; threaded ones are profiled at every
+// thread count in the selection's list
+struct SelectCandidate {
+    std::string kernel;
+    std::string variant;
+    bool threaded;
+    ThreadedSetup setup;
+};
+
+enum SelectObjective {
+    MIN_ENERGY,                 // lowest package joules per call
+    MIN_EDP                     // lowest energy-delay product (J * s per call)
+};
+
+struct CandidateProfile {
+    std::string variant;
+    int threads;
+    double time_s;              // median time per call
+    double energy_j;            // median package energy per call, -1 without RAPL
+
+    double edp() const { return energy_j * time_s; }
+};
+
+struct EnergySelection {
+    std::string kernel;
+    long size;
+    std::string objective;      // "energy", "edp", or "time" when RAPL was unreadable
+    std::string variant;
+    int threads;
+    double time_s;
+    double energy_j;
+    bool cached;                // decision came from the cache, profiles is empty
+    std::vector<CandidateProfile> profiles;
+};
+
+// Picks the lowest-energy (or lowest-EDP) implementation and thread count
+// of a kernel for one problem size from in-process RAPL readings, and keeps
+// the decision in a per-machine cache file so later runs can reuse it.
+class EnergySelector {
+public:
+    explicit EnergySelector(const std::string& cache_path);
+
+    void add_candidate(const SelectCandidate& candidate);
+
+    // Kernels with at least one candidate
+    std::vector<std::string> kernels() const;
+
+    // Returns the cached decision for this machine, kernel, size and
+    // objective, or profiles every candidate (timing options from options)
+    // and caches the winner. refresh ignores the cache. False on error().
+    bool select(const std::string& kernel, long size, SelectObjective objective,
+                const std::vector<int>& thread_counts, const BenchOptions& options,
+                bool refresh, EnergySelection& out);
+
+    const std::string& error() const;
+
+private:
+    EnergySelector(const EnergySelector&);
+    EnergySelector& operator=(const EnergySelector&);
+
+    void load_cache();
+    bool save_cache();
+
+    std::string cache_path;
+    std::string machine;        // host, CPU model and CPU count
+    std::vector<SelectCandidate> candidates;
+    std::map<std::string, EnergySelection> cache;   // by cache_key()
+    std::string error_msg;
+};
+
+const char* objective_name(SelectObjective objective);
+
+#endif // ENERGY_SELECTOR_H
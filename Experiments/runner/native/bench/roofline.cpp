@@ -0,0 +1,93 @@
+// roofline.cpp
+#include "roofline.h"
+#include "bench_harness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static const int PROBE_RUNS = 10;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double MachineRoofline::ridge_point() const {
+    return bandwidth_gbs > 0.0 ? peak_gflops / bandwidth_gbs : 0.0;
+}
+
+double MachineRoofline::attainable_gflops(double intensity) const {
+    return std::min(peak_gflops, intensity * bandwidth_gbs);
+}
+
+// CHAINS independent multiply-add chains, enough to cover the FMA latency
+// on every port; the fixed-size inner loop is unrolled and vectorized
+template <int CHAINS>
+static double fma_gflops(long iterations) {
+    double acc[CHAINS];
+    for (int j = 0; j < CHAINS; j++) {
+        acc[j] = 1.0 + j * 1e-3;
+    }
+    const double mul = 0.9999999;
+    const double add = 1e-7;
+
+    Clock::time_point start = Clock::now();
+    for (long it = 0; it < iterations; it++) {
+        for (int j = 0; j < CHAINS; j++) {
+            acc[j] = acc[j] * mul + add;
+        }
+    }
+    double elapsed = seconds_since(start);
+
+    double sum = 0.0;
+    for (int j = 0; j < CHAINS; j++) {
+        sum += acc[j];
+    }
+    do_not_optimize(sum);
+    return 2.0 * CHAINS * iterations / elapsed / 1e9;
+}
+
+double probe_peak_gflops() {
+    const long iterations = 2000000;
+    double best = 0.0;
+    for (int r = 0; r < PROBE_RUNS; r++) {
+        // The best chain count depends on vector width and FMA latency
+        best = std::max(best, fma_gflops<16>(iterations));
+        best = std::max(best, fma_gflops<32>(iterations));
+        best = std::max(best, fma_gflops<64>(iterations));
+    }
+    return best;
+}
+
+double probe_stream_bandwidth(size_t array_bytes) {
+    size_t n = std::max<size_t>(array_bytes / sizeof(double), 1);
+    std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+    const double scalar = 3.0;
+
+    double best_s = 0.0;
+    for (int r = 0; r < PROBE_RUNS; r++) {
+        Clock::time_point start = Clock::now();
+        double* pa = a.data();
+        const double* pb = b.data();
+        const double* pc = c.data();
+        for (size_t i = 0; i < n; i++) {
+            pa[i] = pb[i] + scalar * pc[i];
+        }
+        do_not_optimize(pa[n / 2]);
+        double elapsed = seconds_since(start);
+        // The first run only faults the pages in
+        if (r > 0 && (best_s == 0.0 || elapsed < best_s)) {
+            best_s = elapsed;
+        }
+    }
+    return best_s > 0.0 ? 3.0 * sizeof(double) * n / best_s / 1e9 : 0.0;
+}
+
+MachineRoofline measure_roofline(size_t array_bytes) {
+    MachineRoofline roof;
+    roof.peak_gflops = probe_peak_gflops();
+    roof.bandwidth_gbs = probe_stream_bandwidth(array_bytes);
+    return roof;
+}
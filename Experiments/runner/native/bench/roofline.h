@@ -0,0 +1,34 @@
+// roofline.h
+#ifndef ROOFLINE_H
+#define ROOFLINE_H
+
+#include <cstddef>
+
+// Single-core roofline of the machine, matching the single-threaded kernels.
+// A kernel with arithmetic intensity I (flop per byte of memory traffic) can
+// reach at most min(peak_gflops, I * bandwidth_gbs).
+struct MachineRoofline {
+    double peak_gflops;         // double-precision FMA throughput
+    double bandwidth_gbs;       // STREAM triad bandwidth from main memory
+
+    MachineRoofline() : peak_gflops(0.0), bandwidth_gbs(0.0) {}
+
+    bool measured() const { return peak_gflops > 0.0 && bandwidth_gbs > 0.0; }
+
+    // Intensity at which the memory roof meets the compute roof
+    double ridge_point() const;
+
+    double attainable_gflops(double intensity) const;
+};
+
+// Best of several runs of independent FMA chains; needs -march=native (or
+// at least -mfma) on roofline.cpp to use the vector FMA units
+double probe_peak_gflops();
+
+// Best-of STREAM triad a[i] = b[i] + s * c[i] over three arrays of
+// array_bytes each, counting 24 bytes per element as STREAM does
+double probe_stream_bandwidth(size_t array_bytes);
+
+MachineRoofline measure_roofline(size_t array_bytes);
+
+#endif // ROOFLINE_H
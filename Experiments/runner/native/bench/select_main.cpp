@@ -0,0 +1,139 @@
+// select_main.cpp
+// Chooses the lowest-energy (or lowest energy-delay product) implementation
+// and thread count of a kernel for one problem size, and caches the choice.
+//
+// Usage:
+//     energy_select --kernel NAME --size N [--objective energy|edp]
+//                   [--threads 1,2,4,...] [--repetitions R] [--min-time SECONDS]
+//                   [--cache FILE] [--refresh] [--list]
+#include "bench_kernels.h"
+#include "energy_selector.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s --kernel NAME --size N [options]\n"
+                 "  --objective energy|edp  minimize joules per call (default) or joules x seconds\n"
+                 "  --threads N,M,...    thread counts for threaded variants (default 1,2,4,.. up to\n"
+                 "                       the number of CPUs)\n"
+                 "  --repetitions R      energy samples per candidate (default 5)\n"
+                 "  --min-time SECONDS   minimum duration of one sample (default 0.05)\n"
+                 "  --cache FILE         decision cache (default build/energy_select.tsv)\n"
+                 "  --refresh            profile again even if a decision is cached\n"
+                 "  --list               list kernels that have candidates\n",
+                 prog);
+}
+
+static std::vector<int> parse_threads(const std::string& arg) {
+    std::vector<int> counts;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty() && std::atoi(item.c_str()) > 0) {
+            counts.push_back(std::atoi(item.c_str()));
+        }
+    }
+    return counts;
+}
+
+static std::vector<int> default_threads() {
+    int cpus = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> counts;
+    for (int t = 1; t < cpus; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(cpus);
+    return counts;
+}
+
+int main(int argc, char** argv) {
+    std::string kernel;
+    long size = 0;
+    SelectObjective objective = MIN_ENERGY;
+    std::vector<int> threads = default_threads();
+    std::string cache_path = "build/energy_select.tsv";
+    bool refresh = false;
+    bool list = false;
+
+    BenchOptions options;
+    options.repetitions = 5;
+    options.min_time_s = 0.05;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (std::strcmp(arg, "--kernel") == 0 && has_value) {
+            kernel = argv[++i];
+        } else if (std::strcmp(arg, "--size") == 0 && has_value) {
+            size = std::atol(argv[++i]);
+        } else if (std::strcmp(arg, "--objective") == 0 && has_value) {
+            std::string value = argv[++i];
+            if (value != "energy" && value != "edp") {
+                usage(argv[0]);
+                return 1;
+            }
+            objective = value == "edp" ? MIN_EDP : MIN_ENERGY;
+        } else if (std::strcmp(arg, "--threads") == 0 && has_value) {
+            threads = parse_threads(argv[++i]);
+        } else if (std::strcmp(arg, "--repetitions") == 0 && has_value) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--min-time") == 0 && has_value) {
+            options.min_time_s = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--cache") == 0 && has_value) {
+            cache_path = argv[++i];
+        } else if (std::strcmp(arg, "--refresh") == 0) {
+            refresh = true;
+        } else if (std::strcmp(arg, "--list") == 0) {
+            list = true;
+        } else {
+            usage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    EnergySelector selector(cache_path);
+    register_select_candidates(selector);
+
+    if (list) {
+        std::vector<std::string> kernels = selector.kernels();
+        for (size_t k = 0; k < kernels.size(); k++) {
+            std::printf("%s\n", kernels[k].c_str());
+        }
+        return 0;
+    }
+
+    if (kernel.empty() || size <= 0 || threads.empty() || options.repetitions < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    EnergySelection selection;
+    if (!selector.select(kernel, size, objective, threads, options, refresh, selection)) {
+        std::fprintf(stderr, "%s\n", selector.error().c_str());
+        return 1;
+    }
+
+    for (size_t i = 0; i < selection.profiles.size(); i++) {
+        const CandidateProfile& p = selection.profiles[i];
+        std::printf("%-12s threads=%-3d time=%12.6f s", p.variant.c_str(), p.threads, p.time_s);
+        if (p.energy_j > 0.0) {
+            std::printf("  energy=%10.6f J  edp=%12.6g J*s", p.energy_j, p.edp());
+        }
+        std::printf("\n");
+    }
+    if (selection.objective == "time") {
+        std::printf("RAPL energy is not readable; chose the fastest configuration (not cached)\n");
+    }
+    std::printf("%s size=%ld -> %s threads=%d (%s%s)\n", selection.kernel.c_str(), selection.size,
+                selection.variant.c_str(), selection.threads, selection.objective.c_str(),
+                selection.cached ? ", cached" : "");
+    return 0;
+}
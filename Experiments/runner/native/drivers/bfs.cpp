@@ -0,0 +1,53 @@
+// bfs.cpp
+// Native driver for bfs/main.py: the same graphs, runs and warm-up, without
+// the interpreter.
+#include "bfs_swig.h"
+#include "driver_common.h"
+#include "driver_metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+static DriverMetrics metrics;
+
+static void benchmark_bfs(int V, int E, int num_runs) {
+    std::string label = "V=" + std::to_string(V) + " E=" + std::to_string(E);
+
+    std::vector<std::pair<Graph, int> > datasets;
+    metrics.span("generate " + label, [&]() {
+        for (int r = 0; r < num_runs; r++) {
+            datasets.push_back(std::make_pair(create_sparse_graph(V, E, false), random_int(0, V - 1)));
+        }
+    });
+
+    Graph warmup = create_sparse_graph(std::max(10, V / 10), std::max(5, E / 10));
+    breadth_first_search(warmup, 0);
+
+    for (size_t r = 0; r < datasets.size(); r++) {
+        const std::pair<Graph, int>& data = datasets[r];
+        metrics.measure(label, [&]() {
+            BFSResult result = breadth_first_search(data.first, data.second);
+            do_not_optimize(result.first);
+        });
+    }
+
+    std::printf("Algorithm: Breadth-First Search (BFS) - native\n");
+    std::printf("Vertices (V): %d\nEdges (E): %d\nTotal Runs: %d\n", V, E, num_runs);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label));
+    std::printf("Latency: %s\n", metrics.format_latency(label).c_str());
+}
+
+int main() {
+    std::printf("--- BFS Benchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Test 1: Sparse Graph (V=10,000, E=25,000) ---\n");
+    benchmark_bfs(10000, 25000, 5);
+
+    std::printf("\n--- Test 2: Sparse Graph (V=50,000, E=75,000) ---\n");
+    benchmark_bfs(50000, 75000, 5);
+
+    return metrics.save() ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+// convex.cpp
+// Native driver for convex/main.py. Like benchmark_convolution(), each test
+// runs the 1D convolution of data_size samples and the 2D convolution of a
+// data_size x data_size image.
+#include "conv_swig.h"
+#include "driver_common.h"
+#include "driver_metrics.h"
+
+#include <cstdio>
+#include <string>
+
+static DriverMetrics metrics;
+
+static void benchmark_convolution(int data_size, int kernel_size, int num_runs) {
+    std::string suffix = " n=" + std::to_string(data_size) + " k=" + std::to_string(kernel_size);
+
+    Vector1D data_1d, kernel_1d;
+    Matrix2D data_2d, kernel_2d;
+    metrics.span("generate" + suffix, [&]() {
+        data_1d = random_vector(data_size);
+        kernel_1d = random_vector(kernel_size);
+        data_2d = random_matrix(data_size, data_size);
+        kernel_2d = random_matrix(kernel_size, kernel_size);
+    });
+
+    std::string label_1d = "conv1d" + suffix;
+    convolution_1d(Vector1D(data_1d.begin(), data_1d.begin() + data_size / 10), kernel_1d);
+    for (int r = 0; r < num_runs; r++) {
+        metrics.measure(label_1d, [&]() {
+            Vector1D out = convolution_1d(data_1d, kernel_1d);
+            do_not_optimize(out.data());
+        });
+    }
+
+    std::string label_2d = "conv2d" + suffix;
+    if (data_size > 10) {
+        Matrix2D warmup(10);
+        for (int i = 0; i < 10; i++) {
+            warmup[i].assign(data_2d[i].begin(), data_2d[i].begin() + 10);
+        }
+        convolution_2d(warmup, kernel_2d);
+    }
+    for (int r = 0; r < num_runs; r++) {
+        metrics.measure(label_2d, [&]() {
+            Matrix2D out = convolution_2d(data_2d, kernel_2d);
+            do_not_optimize(out.data());
+        });
+    }
+
+    std::printf("Algorithm: Convolution 1D (native)\n");
+    std::printf("Data Size: %d elements, kernel %dx1\n", data_size, kernel_size);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label_1d));
+    std::printf("Latency: %s\n", metrics.format_latency(label_1d).c_str());
+    std::printf("Algorithm: Convolution 2D (native)\n");
+    std::printf("Data Size: %dx%d pixels, kernel %dx%d\n", data_size, data_size, kernel_size, kernel_size);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label_2d));
+    std::printf("Latency: %s\n", metrics.format_latency(label_2d).c_str());
+}
+
+int main() {
+    std::printf("--- Convolution Benchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Test 1: n=600, k=7 ---\n");
+    benchmark_convolution(600, 7, 10);
+
+    std::printf("\n--- Test 2: n=250, k=5 ---\n");
+    benchmark_convolution(250, 5, 5);
+
+    return metrics.save() ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+// dense_matrix.cpp
+// Native driver for dense_matrix/main.py, with the same options and defaults:
+//     dense_matrix [--size N] [--runs R] [--method swig_naive|swig_blocked|swig_transpose|swig_parallel]
+//                  [--block B] [--threads T]
+// The method names are main.py's, so the result labels match the SWIG runs.
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "matmul_swig.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static DriverMetrics metrics;
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s [--size N] [--runs R]\n"
+                 "          [--method swig_naive|swig_blocked|swig_transpose|swig_parallel]\n"
+                 "          [--block B] [--threads T]\n",
+                 prog);
+}
+
+int main(int argc, char** argv) {
+    int N = 512;
+    int runs = 3;
+    std::string method = "swig_naive";
+    int block_size = 64;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if ((std::strcmp(arg, "--size") == 0 || std::strcmp(arg, "-n") == 0) && has_value) {
+            N = std::atoi(argv[++i]);
+        } else if ((std::strcmp(arg, "--runs") == 0 || std::strcmp(arg, "-r") == 0) && has_value) {
+            runs = std::atoi(argv[++i]);
+        } else if ((std::strcmp(arg, "--method") == 0 || std::strcmp(arg, "-m") == 0) && has_value) {
+            method = argv[++i];
+        } else if ((std::strcmp(arg, "--block") == 0 || std::strcmp(arg, "-b") == 0) && has_value) {
+            block_size = std::atoi(argv[++i]);
+        } else if ((std::strcmp(arg, "--threads") == 0 || std::strcmp(arg, "-t") == 0) && has_value) {
+            threads = std::atoi(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (N < 8 || runs < 1 || (method != "swig_naive" && method != "swig_blocked" &&
+                               method != "swig_transpose" && method != "swig_parallel")) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Matrix2D A, B;
+    metrics.span("generate N=" + std::to_string(N), [&]() {
+        A = random_matrix(N, N);
+        B = random_matrix(N, N);
+    });
+
+    Matrix2D warmup_A(8), warmup_B(8);
+    for (int i = 0; i < 8; i++) {
+        warmup_A[i].assign(A[i].begin(), A[i].begin() + 8);
+        warmup_B[i].assign(B[i].begin(), B[i].begin() + 8);
+    }
+    matmul_naive(warmup_A, warmup_B);
+
+    std::string label = method + " N=" + std::to_string(N);
+    for (int r = 0; r < runs; r++) {
+        long long ns = metrics.measure(label, [&]() {
+            Matrix2D C;
+            if (method == "swig_naive") {
+                C = matmul_naive(A, B);
+            } else if (method == "swig_blocked") {
+                C = matmul_blocked(A, B, block_size);
+            } else if (method == "swig_transpose") {
+                C = matmul_transpose(A, B);
+            } else {
+                C = matmul_parallel(A, B, threads);
+            }
+            do_not_optimize(C.data());
+        });
+        double elapsed = ns * 1e-9;
+        double gflops = 2.0 * N * N * N / (elapsed * 1e9);
+        std::printf("[Run %d/%d] %-15s | N=%4d | Time=%.4fs | %.2f GFLOPS\n",
+                    r + 1, runs, method.c_str(), N, elapsed, gflops);
+    }
+    std::printf("%-15s | N=%4d | Latency: %s\n", method.c_str(), N, metrics.format_latency(label).c_str());
+
+    return metrics.save() ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+// driver_common.h
+// Input generation shared by the standalone drivers
+#ifndef DRIVER_COMMON_H
+#define DRIVER_COMMON_H
+
+#include <random>
+#include <vector>
+
+// Fixed seed so every run of a driver sees the same inputs
+inline std::mt19937& driver_rng() {
+    static std::mt19937 engine(12345);
+    return engine;
+}
+
+// Uniform in [lo, hi), like random.uniform()
+inline double random_uniform(double lo = 0.0, double hi = 1.0) {
+    std::uniform_real_distribution<double> dist(lo, hi);
+    return dist(driver_rng());
+}
+
+// Uniform integer in [lo, hi], like random.randint()
+inline int random_int(int lo, int hi) {
+    std::uniform_int_distribution<int> dist(lo, hi);
+    return dist(driver_rng());
+}
+
+inline std::vector<double> random_vector(long n) {
+    std::vector<double> v(n);
+    for (long i = 0; i < n; i++) {
+        v[i] = random_uniform();
+    }
+    return v;
+}
+
+inline std::vector<std::vector<double> > random_matrix(long rows, long cols) {
+    std::vector<std::vector<double> > m(rows);
+    for (long i = 0; i < rows; i++) {
+        m[i] = random_vector(cols);
+    }
+    return m;
+}
+
+// Keep the compiler from discarding a kernel result
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif // DRIVER_COMMON_H
@@ -0,0 +1,219 @@
+// driver_metrics.cpp
+#include "driver_metrics.h"
+#include "trace_spans.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+static const char* METRICS_ENV = "KERNEL_METRICS_OUT";
+static const char* TRACE_ENV = "KERNEL_TRACE_OUT";
+
+static std::string env_path(const char* name) {
+    const char* value = std::getenv(name);
+    return value ? value : "";
+}
+
+static std::string json_escape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size(); i++) {
+        char c = s[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// Value, or null for the -1 'unavailable' marker
+static std::string counter(long long value) {
+    if (value < 0) {
+        return "null";
+    }
+    std::ostringstream ss;
+    ss << value;
+    return ss.str();
+}
+
+static std::string rounded(double value, int digits) {
+    double scale = std::pow(10.0, digits);
+    std::ostringstream ss;
+    ss.precision(15);
+    ss << std::round(value * scale) / scale;
+    return ss.str();
+}
+
+static std::string energy_j(double value) {
+    return value >= 0 ? rounded(value, 6) : "null";
+}
+
+static std::string ms(double ns) {
+    return rounded(ns / 1e6, 6);
+}
+
+DriverMetrics::DriverMetrics() : call_count(0) {
+    if (!env_path(TRACE_ENV).empty()) {
+        trace_thread_name("driver");
+        trace_enable(true);
+    }
+}
+
+long long DriverMetrics::measure(const std::string& label, const std::function<void()>& call) {
+    if (latency.find(label) == latency.end()) {
+        labels.push_back(label);
+    }
+    LatencyRecorder& recorder = latency[label];
+
+    heap.start();
+    counters.start();
+    energy.start();
+    // Innermost, so the latency excludes the counter reads
+    recorder.start();
+    call();
+    long long ns = recorder.stop();
+
+    if (trace_enabled()) {
+        long long end = now_ns();
+        trace_record("native", label, end - ns, end);
+    }
+    joules.accumulate(energy.stop());
+    totals.accumulate(counters.stop());
+    if (heap.available()) {
+        LabelAllocations& entry = allocations[label];
+        entry.calls++;
+        entry.sample.accumulate(heap.stop());
+    }
+    call_count++;
+    return ns;
+}
+
+void DriverMetrics::span(const std::string& name, const std::function<void()>& call) {
+    if (!trace_enabled()) {
+        call();
+        return;
+    }
+    long long start = now_ns();
+    call();
+    trace_record("driver", name, start, now_ns());
+}
+
+double DriverMetrics::average_ms(const std::string& label) const {
+    std::map<std::string, LatencyRecorder>::const_iterator it = latency.find(label);
+    return it == latency.end() ? 0.0 : it->second.histogram().mean() / 1e6;
+}
+
+std::string DriverMetrics::format_latency(const std::string& label) const {
+    std::map<std::string, LatencyRecorder>::const_iterator it = latency.find(label);
+    if (it == latency.end()) {
+        return "";
+    }
+    const LatencyHistogram& hist = it->second.histogram();
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "p50 %.4f ms | p90 %.4f ms | p99 %.4f ms | max %.4f ms",
+                  hist.percentile(50) / 1e6, hist.percentile(90) / 1e6,
+                  hist.percentile(99) / 1e6, hist.max() / 1e6);
+    return buf;
+}
+
+long DriverMetrics::calls() const {
+    return call_count;
+}
+
+bool DriverMetrics::save() const {
+    bool ok = true;
+    std::string trace_path = env_path(TRACE_ENV);
+    if (!trace_path.empty() && trace_enabled()) {
+        ok = trace_write_json(trace_path) && ok;
+    }
+    std::string path = env_path(METRICS_ENV);
+    if (!path.empty()) {
+        ok = write_json(path) && ok;
+    }
+    return ok;
+}
+
+// Same keys as KernelMetrics.as_dict()
+bool DriverMetrics::write_json(const std::string& path) const {
+    std::ofstream os(path.c_str());
+    if (!os) {
+        return false;
+    }
+
+    long heap_calls = 0;
+    AllocationSample heap_total;
+    for (std::map<std::string, LabelAllocations>::const_iterator it = allocations.begin();
+         it != allocations.end(); ++it) {
+        heap_calls += it->second.calls;
+        heap_total.accumulate(it->second.sample);
+    }
+
+    os << "{\n";
+    os << "  \"kernel_calls\": " << call_count << ",\n";
+    os << "  \"cycles\": " << counter(totals.cycles) << ",\n";
+    os << "  \"instructions\": " << counter(totals.instructions) << ",\n";
+    os << "  \"ipc\": " << (totals.cycles > 0 ? rounded(totals.ipc(), 3) : "null") << ",\n";
+    os << "  \"l1d_misses\": " << counter(totals.l1d_misses) << ",\n";
+    os << "  \"llc_misses\": " << counter(totals.llc_misses) << ",\n";
+    os << "  \"branch_misses\": " << counter(totals.branch_misses) << ",\n";
+    os << "  \"kernel_energy_j\": " << energy_j(joules.package_j) << ",\n";
+    os << "  \"kernel_energy_per_call_j\": "
+       << (call_count && joules.package_j >= 0 ? energy_j(joules.package_j / call_count) : "null") << ",\n";
+    os << "  \"kernel_dram_energy_j\": " << energy_j(joules.dram_j) << ",\n";
+    os << "  \"kernel_allocations_per_call\": "
+       << (heap_calls ? rounded(double(heap_total.allocations) / heap_calls, 3) : "null") << ",\n";
+    os << "  \"kernel_alloc_bytes_per_call\": "
+       << (heap_calls ? rounded(double(heap_total.bytes) / heap_calls, 1) : "null") << ",\n";
+    os << "  \"kernel_peak_alloc_bytes\": " << (heap_calls ? counter(heap_total.peak_bytes) : "null") << ",\n";
+
+    os << "  \"allocations\": {";
+    bool first = true;
+    for (size_t l = 0; l < labels.size(); l++) {
+        std::map<std::string, LabelAllocations>::const_iterator it = allocations.find(labels[l]);
+        if (it == allocations.end()) {
+            continue;
+        }
+        const LabelAllocations& entry = it->second;
+        os << (first ? "\n" : ",\n") << "    \"" << json_escape(labels[l]) << "\": {"
+           << "\"allocations_per_call\": " << rounded(double(entry.sample.allocations) / entry.calls, 3)
+           << ", \"bytes_per_call\": " << rounded(double(entry.sample.bytes) / entry.calls, 1)
+           << ", \"peak_bytes\": " << entry.sample.peak_bytes << "}";
+        first = false;
+    }
+    os << (first ? "},\n" : "\n  },\n");
+
+    os << "  \"latency\": {";
+    for (size_t l = 0; l < labels.size(); l++) {
+        const LatencyRecorder& recorder = latency.find(labels[l])->second;
+        const LatencyHistogram& hist = recorder.histogram();
+        std::vector<long long> samples = recorder.samples();
+        os << (l ? ",\n" : "\n") << "    \"" << json_escape(labels[l]) << "\": {\n"
+           << "      \"count\": " << hist.count() << ",\n"
+           << "      \"mean_ms\": " << ms(hist.mean()) << ",\n"
+           << "      \"min_ms\": " << ms(hist.min()) << ",\n"
+           << "      \"p50_ms\": " << ms(hist.percentile(50)) << ",\n"
+           << "      \"p90_ms\": " << ms(hist.percentile(90)) << ",\n"
+           << "      \"p99_ms\": " << ms(hist.percentile(99)) << ",\n"
+           << "      \"max_ms\": " << ms(hist.max()) << ",\n"
+           << "      \"samples_ms\": [";
+        for (size_t s = 0; s < samples.size(); s++) {
+            os << (s ? ", " : "") << ms(samples[s]);
+        }
+        os << "]\n    }";
+    }
+    os << (labels.empty() ? "},\n" : "\n  },\n");
+
+    // The drivers run a fixed number of calls, as main.py does
+    os << "  \"precision\": {}\n";
+    os << "}\n";
+    return os.good();
+}
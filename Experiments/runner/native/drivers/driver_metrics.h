@@ -0,0 +1,66 @@
+// driver_metrics.h
+#ifndef DRIVER_METRICS_H
+#define DRIVER_METRICS_H
+
+#include "allocation_tracker.h"
+#include "latency_histogram.h"
+#include "perf_counters.h"
+#include "rapl_energy.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Native counterpart of kernel_metrics.py for the standalone drivers.
+// measure() reads the hardware counters, RAPL energy, heap counters and a
+// per-label latency histogram around one kernel call, and save() writes
+// them to $KERNEL_METRICS_OUT in the same JSON layout as KernelMetrics, so
+// RunnerConfig fills the same run table columns for the native runs.
+class DriverMetrics {
+public:
+    DriverMetrics();
+
+    // Runs call() once as a measured kernel call under label; returns its
+    // latency in nanoseconds
+    long long measure(const std::string& label, const std::function<void()>& call);
+
+    // Records call() (e.g. input generation) on the trace timeline
+    void span(const std::string& name, const std::function<void()>& call);
+
+    double average_ms(const std::string& label) const;
+
+    // "p50 x ms | p90 x ms | p99 x ms | max x ms", as format_latency()
+    std::string format_latency(const std::string& label) const;
+
+    long calls() const;
+
+    // Writes the metrics to $KERNEL_METRICS_OUT and the trace spans to
+    // $KERNEL_TRACE_OUT when those are set. False if a file could not be written.
+    bool save() const;
+
+private:
+    DriverMetrics(const DriverMetrics&);
+    DriverMetrics& operator=(const DriverMetrics&);
+
+    struct LabelAllocations {
+        long calls;
+        AllocationSample sample;
+
+        LabelAllocations() : calls(0) {}
+    };
+
+    bool write_json(const std::string& path) const;
+
+    PerfCounters counters;
+    PerfSample totals;
+    RaplEnergy energy;
+    EnergyReading joules;
+    AllocationTracker heap;
+    std::vector<std::string> labels;                    // in first-measured order
+    std::map<std::string, LatencyRecorder> latency;
+    std::map<std::string, LabelAllocations> allocations;
+    long call_count;
+};
+
+#endif // DRIVER_METRICS_H
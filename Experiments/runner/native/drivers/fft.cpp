@@ -0,0 +1,79 @@
+// fft.cpp
+// Native driver for fft/main.py, with the same options and defaults:
+//     fft [--size N] [--runs R] [--method swig_naive|swig_recursive|swig_iterative]
+// The method names are main.py's, so the result labels match the SWIG runs.
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "fft_swig.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static DriverMetrics metrics;
+
+static void usage(const char* prog) {
+    std::fprintf(stderr, "Usage: %s [--size N] [--runs R] [--method swig_naive|swig_recursive|swig_iterative]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    int N = 1024;
+    int runs = 3;
+    std::string method = "swig_iterative";
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if ((std::strcmp(arg, "--size") == 0 || std::strcmp(arg, "-n") == 0) && has_value) {
+            N = std::atoi(argv[++i]);
+        } else if ((std::strcmp(arg, "--runs") == 0 || std::strcmp(arg, "-r") == 0) && has_value) {
+            runs = std::atoi(argv[++i]);
+        } else if ((std::strcmp(arg, "--method") == 0 || std::strcmp(arg, "-m") == 0) && has_value) {
+            method = argv[++i];
+        } else {
+            usage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (N < 8 || runs < 1 || (method != "swig_naive" && method != "swig_recursive" &&
+                               method != "swig_iterative")) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    ComplexVector x;
+    metrics.span("generate N=" + std::to_string(N), [&]() {
+        x.resize(N);
+        for (int i = 0; i < N; i++) {
+            double re = random_uniform();
+            x[i] = Complex(re, random_uniform());
+        }
+    });
+
+    dft_naive(ComplexVector(x.begin(), x.begin() + 8));
+
+    std::string label = method + " N=" + std::to_string(N);
+    for (int r = 0; r < runs; r++) {
+        long long ns = metrics.measure(label, [&]() {
+            ComplexVector X;
+            if (method == "swig_naive") {
+                X = dft_naive(x);
+            } else if (method == "swig_recursive") {
+                X = fft_cooley_tukey(x);
+            } else {
+                X = fft_iterative(x);
+            }
+            do_not_optimize(X.data());
+        });
+        double elapsed = ns * 1e-9;
+        double flops = method == "swig_naive" ? 8.0 * N * N : 5.0 * N * std::log2(static_cast<double>(N));
+        std::printf("[Run %d/%d] %-15s | N=%6d | Time=%.6fs | %.3f GFLOPS-eq\n",
+                    r + 1, runs, method.c_str(), N, elapsed, flops / (elapsed * 1e9));
+    }
+    std::printf("%-15s | N=%6d | Latency: %s\n", method.c_str(), N, metrics.format_latency(label).c_str());
+
+    return metrics.save() ? 0 : 1;
+}
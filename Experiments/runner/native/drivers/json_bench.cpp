@@ -0,0 +1,440 @@
+// json_bench.cpp
+// Native driver for json_bench/main.py. main.py times Python's json.dumps()
+// and json.loads(); there is no JSON kernel among the SWIG modules, so this
+// driver carries a small document type, writer and recursive-descent parser
+// and times those on the same record layout (strings from the json_swig
+// kernel's generate_random_string()).
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "json_swig.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+static DriverMetrics metrics;
+
+// A parsed JSON document. Objects keep their keys in keys[], parallel to items[].
+struct JsonValue {
+    enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+    Type type;
+    bool boolean;
+    bool integer;               // number written without a fraction
+    double number;
+    std::string text;
+    std::vector<std::string> keys;
+    std::vector<JsonValue> items;
+
+    JsonValue() : type(NUL), boolean(false), integer(false), number(0) {}
+
+    static JsonValue make_bool(bool b) {
+        JsonValue v;
+        v.type = BOOL;
+        v.boolean = b;
+        return v;
+    }
+    static JsonValue make_int(long long n) {
+        JsonValue v;
+        v.type = NUMBER;
+        v.integer = true;
+        v.number = static_cast<double>(n);
+        return v;
+    }
+    static JsonValue make_float(double n) {
+        JsonValue v;
+        v.type = NUMBER;
+        v.number = n;
+        return v;
+    }
+    static JsonValue make_string(const std::string& s) {
+        JsonValue v;
+        v.type = STRING;
+        v.text = s;
+        return v;
+    }
+    static JsonValue make(Type type) {
+        JsonValue v;
+        v.type = type;
+        return v;
+    }
+
+    void add(const std::string& key, const JsonValue& value) {
+        keys.push_back(key);
+        items.push_back(value);
+    }
+};
+
+// --- Encoding, with json.dumps()'s default ", " and ": " separators ---
+
+static void dump_string(const std::string& s, std::string& out) {
+    out += '"';
+    for (size_t i = 0; i < s.size(); i++) {
+        char c = s[i];
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+static void dump(const JsonValue& v, std::string& out) {
+    char buf[32];
+    switch (v.type) {
+    case JsonValue::NUL:
+        out += "null";
+        break;
+    case JsonValue::BOOL:
+        out += v.boolean ? "true" : "false";
+        break;
+    case JsonValue::NUMBER:
+        if (v.integer) {
+            std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(v.number));
+        } else {
+            std::snprintf(buf, sizeof(buf), "%.17g", v.number);
+        }
+        out += buf;
+        break;
+    case JsonValue::STRING:
+        dump_string(v.text, out);
+        break;
+    case JsonValue::ARRAY:
+        out += '[';
+        for (size_t i = 0; i < v.items.size(); i++) {
+            if (i) {
+                out += ", ";
+            }
+            dump(v.items[i], out);
+        }
+        out += ']';
+        break;
+    case JsonValue::OBJECT:
+        out += '{';
+        for (size_t i = 0; i < v.items.size(); i++) {
+            if (i) {
+                out += ", ";
+            }
+            dump_string(v.keys[i], out);
+            out += ": ";
+            dump(v.items[i], out);
+        }
+        out += '}';
+        break;
+    }
+}
+
+static std::string dumps(const JsonValue& v) {
+    std::string out;
+    dump(v, out);
+    return out;
+}
+
+// --- Decoding ---
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : p(text.c_str()), end(text.c_str() + text.size()) {}
+
+    // False on malformed input or trailing characters
+    bool parse(JsonValue& out) {
+        return value(out) && (skip_space(), p == end);
+    }
+
+private:
+    void skip_space() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+            p++;
+        }
+    }
+
+    bool literal(const char* word) {
+        size_t n = std::strlen(word);
+        if (static_cast<size_t>(end - p) < n || std::strncmp(p, word, n) != 0) {
+            return false;
+        }
+        p += n;
+        return true;
+    }
+
+    static void append_utf8(unsigned code, std::string& out) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xc0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        } else {
+            out += static_cast<char>(0xe0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        }
+    }
+
+    bool string(std::string& out) {
+        if (p == end || *p != '"') {
+            return false;
+        }
+        p++;
+        out.clear();
+        while (p < end && *p != '"') {
+            // Copy unescaped runs in one go
+            const char* run = p;
+            while (p < end && *p != '"' && *p != '\\') {
+                p++;
+            }
+            out.append(run, p);
+            if (p == end || *p == '"') {
+                break;
+            }
+            if (++p == end) {
+                return false;
+            }
+            char c = *p++;
+            switch (c) {
+            case '"': case '\\': case '/': out += c; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                if (end - p < 4) {
+                    return false;
+                }
+                char hex[5] = {p[0], p[1], p[2], p[3], 0};
+                append_utf8(static_cast<unsigned>(std::strtoul(hex, NULL, 16)), out);
+                p += 4;
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        if (p == end) {
+            return false;
+        }
+        p++;
+        return true;
+    }
+
+    bool number(JsonValue& out) {
+        const char* start = p;
+        if (p < end && *p == '-') {
+            p++;
+        }
+        bool integer = true;
+        while (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' ||
+                           *p == '+' || *p == '-')) {
+            integer = integer && *p >= '0' && *p <= '9';
+            p++;
+        }
+        if (p == start) {
+            return false;
+        }
+        out.type = JsonValue::NUMBER;
+        out.integer = integer;
+        out.number = std::strtod(std::string(start, p).c_str(), NULL);
+        return true;
+    }
+
+    bool value(JsonValue& out) {
+        skip_space();
+        if (p == end) {
+            return false;
+        }
+        switch (*p) {
+        case '{': {
+            p++;
+            out = JsonValue::make(JsonValue::OBJECT);
+            skip_space();
+            if (p < end && *p == '}') {
+                p++;
+                return true;
+            }
+            while (true) {
+                skip_space();
+                std::string key;
+                if (!string(key)) {
+                    return false;
+                }
+                skip_space();
+                if (p == end || *p++ != ':') {
+                    return false;
+                }
+                out.keys.push_back(key);
+                out.items.push_back(JsonValue());
+                if (!value(out.items.back())) {
+                    return false;
+                }
+                skip_space();
+                if (p < end && *p == ',') {
+                    p++;
+                } else if (p < end && *p == '}') {
+                    p++;
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+        }
+        case '[': {
+            p++;
+            out = JsonValue::make(JsonValue::ARRAY);
+            skip_space();
+            if (p < end && *p == ']') {
+                p++;
+                return true;
+            }
+            while (true) {
+                out.items.push_back(JsonValue());
+                if (!value(out.items.back())) {
+                    return false;
+                }
+                skip_space();
+                if (p < end && *p == ',') {
+                    p++;
+                } else if (p < end && *p == ']') {
+                    p++;
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+        }
+        case '"':
+            out.type = JsonValue::STRING;
+            return string(out.text);
+        case 't':
+            out = JsonValue::make_bool(true);
+            return literal("true");
+        case 'f':
+            out = JsonValue::make_bool(false);
+            return literal("false");
+        case 'n':
+            out = JsonValue();
+            return literal("null");
+        default:
+            return number(out);
+        }
+    }
+
+    const char* p;
+    const char* end;
+};
+
+// --- Data generation, the record layout of create_complex_data() ---
+
+static double round2(double x) {
+    return std::round(x * 100.0) / 100.0;
+}
+
+static JsonValue create_complex_data(int num_records) {
+    double now = static_cast<double>(std::time(NULL));
+    JsonValue records = JsonValue::make(JsonValue::ARRAY);
+    records.items.reserve(num_records);
+
+    for (int i = 0; i < num_records; i++) {
+        JsonValue record = JsonValue::make(JsonValue::OBJECT);
+        record.add("id", JsonValue::make_int(i));
+        record.add("uuid", JsonValue::make_string(generate_random_string(32)));
+        record.add("isActive", JsonValue::make_bool(random_int(0, 1) == 1));
+        record.add("balance", JsonValue::make_float(round2(random_uniform(10.0, 50000.0))));
+
+        JsonValue tags = JsonValue::make(JsonValue::ARRAY);
+        for (int t = random_int(2, 5); t > 0; t--) {
+            tags.items.push_back(JsonValue::make_string(generate_random_string(5)));
+        }
+        record.add("tags", tags);
+
+        JsonValue profile = JsonValue::make(JsonValue::OBJECT);
+        profile.add("age", JsonValue::make_int(random_int(18, 65)));
+        profile.add("city", JsonValue::make_string(generate_random_string(10)));
+        profile.add("isVerified", JsonValue::make_bool(random_int(0, 1) == 1));
+        record.add("profile", profile);
+
+        JsonValue history = JsonValue::make(JsonValue::ARRAY);
+        for (int h = random_int(1, 3); h > 0; h--) {
+            JsonValue entry = JsonValue::make(JsonValue::OBJECT);
+            entry.add("timestamp", JsonValue::make_float(now - random_int(100, 10000)));
+            entry.add("amount", JsonValue::make_float(round2(random_uniform(-100.0, 100.0))));
+            history.items.push_back(entry);
+        }
+        record.add("history", history);
+
+        records.items.push_back(record);
+    }
+
+    JsonValue metadata = JsonValue::make(JsonValue::OBJECT);
+    metadata.add("count", JsonValue::make_int(num_records));
+    metadata.add("timestamp", JsonValue::make_float(now));
+
+    JsonValue data = JsonValue::make(JsonValue::OBJECT);
+    data.add("metadata", metadata);
+    data.add("records", records);
+    return data;
+}
+
+static bool benchmark_json_io(int num_records, int num_runs) {
+    JsonValue data;
+    metrics.span("generate records=" + std::to_string(num_records),
+                 [&]() { data = create_complex_data(num_records); });
+
+    // Warm-up run, which also checks that the parser accepts the writer's output
+    JsonValue parsed;
+    if (!JsonParser(dumps(data)).parse(parsed)) {
+        std::fprintf(stderr, "json_bench: could not parse the encoded records\n");
+        return false;
+    }
+
+    std::string label_dump = "dumps records=" + std::to_string(num_records);
+    std::string label_load = "loads records=" + std::to_string(num_records);
+    std::string json_string;
+    for (int r = 0; r < num_runs; r++) {
+        metrics.measure(label_dump, [&]() { json_string = dumps(data); });
+        metrics.measure(label_load, [&]() {
+            JsonValue decoded;
+            JsonParser(json_string).parse(decoded);
+            do_not_optimize(decoded.items.data());
+        });
+    }
+
+    double dump_ms = metrics.average_ms(label_dump);
+    double load_ms = metrics.average_ms(label_load);
+    std::printf("Algorithm: JSON Encode/Decode (native)\n");
+    std::printf("Records Processed: %d\n", num_records);
+    std::printf("Approx. JSON Size: %.2f KB\n", json_string.size() / 1024.0);
+    std::printf("Total Runs: %d\n", num_runs);
+    std::printf("  Avg. Encode (dumps) Time: %.4f ms\n", dump_ms);
+    std::printf("  Avg. Decode (loads) Time: %.4f ms\n", load_ms);
+    std::printf("  Avg. Total I/O Time:      %.4f ms\n", dump_ms + load_ms);
+    std::printf("  Encode latency: %s\n", metrics.format_latency(label_dump).c_str());
+    std::printf("  Decode latency: %s\n", metrics.format_latency(label_load).c_str());
+    return true;
+}
+
+int main() {
+    std::printf("--- JSON Encode/Decode Microbenchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Test 1: 5,000 Complex Records ---\n");
+    bool ok = benchmark_json_io(5000, 10);
+
+    std::printf("\n--- Test 2: 20,000 Complex Records ---\n");
+    ok = benchmark_json_io(20000, 5) && ok;
+
+    return metrics.save() && ok ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+// k_means.cpp
+// Native driver for k_means/main.py: one K-means iteration per run, each
+// run from its own random centroids.
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "kmeans_swig.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static DriverMetrics metrics;
+
+static void benchmark_kmeans(int N, int D, int K, int num_runs) {
+    std::string label = "N=" + std::to_string(N) + " D=" + std::to_string(D) + " K=" + std::to_string(K);
+
+    DataSet data;
+    std::vector<DataSet> initial_centroids;
+    metrics.span("generate " + label, [&]() {
+        data = initialize_data(N, D);
+        for (int r = 0; r < num_runs; r++) {
+            initial_centroids.push_back(initialize_centroids(data, K));
+        }
+    });
+
+    DataSet warmup = initialize_data(std::max(10, N / 10), std::max(1, D));
+    kmeans_iteration(warmup, initialize_centroids(warmup, std::max(1, K)));
+
+    for (int r = 0; r < num_runs; r++) {
+        const DataSet& centroids = initial_centroids[r];
+        metrics.measure(label, [&]() {
+            DataSet updated = kmeans_iteration(data, centroids);
+            do_not_optimize(updated.data());
+        });
+    }
+
+    std::printf("Algorithm: K-means Single Iteration (native)\n");
+    std::printf("Data Points (N): %d\nDimensions (D): %d\nClusters (K): %d\nTotal Runs: %d\n",
+                N, D, K, num_runs);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label));
+    std::printf("Latency: %s\n", metrics.format_latency(label).c_str());
+}
+
+int main() {
+    std::printf("--- K-means Single Iteration Benchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Test 1: N=20,000, D=5, K=10 ---\n");
+    benchmark_kmeans(20000, 5, 10, 5);
+
+    std::printf("\n--- Test 2: N=5,000, D=100, K=15 (Focus on dimensionality) ---\n");
+    benchmark_kmeans(5000, 100, 15, 5);
+
+    return metrics.save() ? 0 : 1;
+}
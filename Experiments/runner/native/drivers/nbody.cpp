@@ -0,0 +1,79 @@
+// nbody.cpp
+// Native driver for nbody/main.py, which times a quicksort before the N-body
+// steps. The native quicksort kernel stands in for main.py's Python one.
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "nbody_swig.h"
+#include "quicksort_swig.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static DriverMetrics metrics;
+
+static void benchmark_quicksort(int data_size, int num_runs) {
+    std::string label = "quicksort n=" + std::to_string(data_size);
+
+    std::vector<std::vector<double> > datasets;
+    for (int r = 0; r < num_runs; r++) {
+        datasets.push_back(random_vector(data_size));
+    }
+    quicksort(random_vector(data_size / 10));
+
+    for (size_t r = 0; r < datasets.size(); r++) {
+        std::vector<double> arr_to_sort = datasets[r];
+        metrics.measure(label, [&]() {
+            std::vector<double> sorted = quicksort(arr_to_sort);
+            do_not_optimize(sorted.data());
+        });
+    }
+
+    std::printf("Algorithm: Quicksort (native)\n");
+    std::printf("Data Size: %d elements\nTotal Runs: %d\n", data_size, num_runs);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label));
+    std::printf("Latency: %s\n", metrics.format_latency(label).c_str());
+}
+
+static void benchmark_nbody(int N, int num_runs, double dt) {
+    std::string label = "nbody N=" + std::to_string(N);
+
+    std::vector<BodiesVector> datasets;
+    metrics.span("generate " + label, [&]() {
+        BodiesVector initial = initialize_bodies(N, 1000.0);
+        datasets.assign(num_runs, initial);
+    });
+
+    nbody_step_update(initialize_bodies(N / 10), dt);
+
+    for (size_t r = 0; r < datasets.size(); r++) {
+        const BodiesVector& bodies = datasets[r];
+        metrics.measure(label, [&]() {
+            BodiesVector updated = nbody_step_update(bodies, dt);
+            do_not_optimize(updated.data());
+        });
+    }
+
+    std::printf("Algorithm: N-Body Simulation Step (native)\n");
+    std::printf("Bodies (N): %d\nTotal Runs: %d\n", N, num_runs);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label));
+    std::printf("Latency: %s\n", metrics.format_latency(label).c_str());
+}
+
+int main() {
+    std::printf("--- Quicksort and N-Body Benchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Benchmarking Quicksort (50,000 elements) ---\n");
+    benchmark_quicksort(50000, 10);
+
+    std::printf("\n--- Benchmarking Quicksort (150,000 elements) ---\n");
+    benchmark_quicksort(150000, 5);
+
+    std::printf("\n--- Benchmarking N-Body (N=500 bodies) ---\n");
+    benchmark_nbody(500, 10, 0.01);
+
+    std::printf("\n--- Benchmarking N-Body (N=1,500 bodies) ---\n");
+    benchmark_nbody(1500, 3, 0.01);
+
+    return metrics.save() ? 0 : 1;
+}
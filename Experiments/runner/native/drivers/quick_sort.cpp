@@ -0,0 +1,50 @@
+// quick_sort.cpp
+// Native driver for quick_sort/main.py: quicksort() (sorts a copy) on fresh
+// random arrays.
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "quicksort_swig.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static DriverMetrics metrics;
+
+static void benchmark_quicksort(int data_size, int num_runs) {
+    std::string label = "n=" + std::to_string(data_size);
+
+    std::vector<std::vector<double> > datasets;
+    metrics.span("generate " + label, [&]() {
+        for (int r = 0; r < num_runs; r++) {
+            datasets.push_back(random_vector(data_size));
+        }
+    });
+
+    quicksort(random_vector(data_size / 10));
+
+    for (size_t r = 0; r < datasets.size(); r++) {
+        const std::vector<double>& data = datasets[r];
+        metrics.measure(label, [&]() {
+            std::vector<double> sorted = quicksort(data);
+            do_not_optimize(sorted.data());
+        });
+    }
+
+    std::printf("Algorithm: Quicksort (native)\n");
+    std::printf("Data Size: %d elements\nTotal Runs: %d\n", data_size, num_runs);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label));
+    std::printf("Latency: %s\n", metrics.format_latency(label).c_str());
+}
+
+int main() {
+    std::printf("--- Quicksort Benchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Test 1: 50,000 elements ---\n");
+    benchmark_quicksort(50000, 10);
+
+    std::printf("\n--- Test 2: 150,000 elements ---\n");
+    benchmark_quicksort(150000, 5);
+
+    return metrics.save() ? 0 : 1;
+}
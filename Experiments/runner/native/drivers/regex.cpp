@@ -0,0 +1,80 @@
+// regex.cpp
+// Native driver for regex/main.py: simple_tokenize() and fast_word_tokenize()
+// on the same generated corpus, labelled with main.py's method names
+// (swig, fast_swig) so the results line up with the SWIG runs.
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "regex_swig.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static DriverMetrics metrics;
+
+// Same corpus as regex/main.py, scaled to size_kb kilobytes
+static std::string make_corpus(int size_kb) {
+    std::string base;
+    for (int i = 0; i < 10; i++) {
+        base += "The quick brown fox jumps over the lazy dog's fence. ";
+    }
+
+    size_t target = static_cast<size_t>(size_kb) * 1024;
+    std::string text;
+    text.reserve(target + base.size());
+    while (text.size() < target) {
+        text += base;
+    }
+    text.resize(target);
+
+    std::string out;
+    out.reserve(text.size() + text.size() / 4);
+    size_t pos = 0;
+    size_t hit;
+    while ((hit = text.find("fox", pos)) != std::string::npos) {
+        out.append(text, pos, hit - pos);
+        out += "12345.67 fox";
+        pos = hit + 3;
+    }
+    out.append(text, pos, std::string::npos);
+    out += " https://example.com/page?id=1";
+    return out;
+}
+
+static void benchmark_tokenizer(int text_size_kb, int num_runs, const std::string& method) {
+    std::string label = method + " " + std::to_string(text_size_kb) + "KB";
+
+    std::string text;
+    metrics.span("generate " + label, [&]() { text = make_corpus(text_size_kb); });
+
+    simple_tokenize(text.substr(0, 1000));
+
+    size_t token_count = 0;
+    for (int r = 0; r < num_runs; r++) {
+        metrics.measure(label, [&]() {
+            std::vector<std::string> tokens = method == "fast_swig" ? fast_word_tokenize(text)
+                                                               : simple_tokenize(text);
+            token_count = tokens.size();
+        });
+    }
+
+    std::printf("Algorithm: Tokenization - %s (native)\n",
+                method == "fast_swig" ? "Fast Word Tokenize" : "Simple Tokenize");
+    std::printf("Text Size: %d KB\nTokens Found: %zu\nTotal Runs: %d\n", text_size_kb, token_count, num_runs);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label));
+    std::printf("Latency: %s\n", metrics.format_latency(label).c_str());
+}
+
+int main() {
+    std::printf("--- Tokenization Benchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Test 1: Text Size 200 KB ---\n");
+    benchmark_tokenizer(200, 10, "swig");
+    benchmark_tokenizer(200, 10, "fast_swig");
+
+    std::printf("\n--- Test 2: Text Size 800 KB ---\n");
+    benchmark_tokenizer(800, 5, "swig");
+    benchmark_tokenizer(800, 5, "fast_swig");
+
+    return metrics.save() ? 0 : 1;
+}
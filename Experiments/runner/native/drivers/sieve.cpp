@@ -0,0 +1,41 @@
+// sieve.cpp
+// Native driver for sieve/main.py
+#include "driver_common.h"
+#include "driver_metrics.h"
+#include "sieve_swig.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static DriverMetrics metrics;
+
+static void benchmark_sieve(int limit, int num_runs) {
+    std::string label = "limit=" + std::to_string(limit);
+    size_t prime_count = 0;
+
+    sieve_of_eratosthenes(limit / 10);
+
+    for (int r = 0; r < num_runs; r++) {
+        metrics.measure(label, [&]() {
+            std::vector<int> primes = sieve_of_eratosthenes(limit);
+            prime_count = primes.size();
+        });
+    }
+
+    std::printf("Limit: %d\nPrimes Found: %zu\nTotal Runs: %d\n", limit, prime_count, num_runs);
+    std::printf("Average Execution Time: %.4f ms\n", metrics.average_ms(label));
+    std::printf("Latency: %s\n", metrics.format_latency(label).c_str());
+}
+
+int main() {
+    std::printf("--- Sieve of Eratosthenes Benchmark Test Runs (native) ---\n");
+
+    std::printf("\n--- Test 1: limit=100,000 ---\n");
+    benchmark_sieve(100000, 20);
+
+    std::printf("\n--- Test 2: limit=1,000,000 ---\n");
+    benchmark_sieve(1000000, 5);
+
+    return metrics.save() ? 0 : 1;
+}
@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+"""
+Kernel Performance Regression Check
+-----------------------------------
+Keeps a baseline of the native kernel benchmarks per machine and compares
+new runs against it.
+
+    python perf_regress.py record  [--filter NAME] [--repetitions 30]
+    python perf_regress.py compare [--filter NAME] [--repetitions 30]
+                                   [--alpha 0.01] [--min-effect 0.03]
+
+Baselines live in baselines/<fingerprint>.json, where the fingerprint hashes
+the CPU model, logical CPU count, kernel release, and the compiler version and
+flags that kernel_bench reports it was built with (the Makefile bakes them
+in), so results from different machines or builds are never compared.
+
+For every benchmark and size, the per-sample times (and per-call package
+energy when --energy is given and RAPL is readable) of the baseline and the
+new run are compared with a two-sided Mann-Whitney U test. A kernel is
+flagged when the difference is significant after Holm correction and its
+median changed by more than --min-effect. The report gives the median change
+and Cliff's delta as effect sizes. compare exits with status 1 if anything
+regressed.
+"""
+import argparse
+import hashlib
+import json
+import math
+import os
+import platform
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+NATIVE_DIR = Path(os.path.dirname(os.path.abspath(__file__)))
+BASELINE_DIR = NATIVE_DIR / "baselines"
+KERNEL_BENCH = NATIVE_DIR / "build" / "kernel_bench"
+
+
+# ------------------ Fingerprint ------------------
+
+def cpu_model():
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor() or "unknown"
+
+
+def machine_fingerprint(report):
+    """Fingerprint of this machine and of the build that produced report."""
+    context = report.get("context", {})
+    info = {
+        "cpu": cpu_model(),
+        "cpus": os.cpu_count(),
+        "kernel": platform.release(),
+        "compiler": context.get("compiler", "unknown"),
+        "build_flags": context.get("build_flags", "unknown"),
+    }
+    digest = hashlib.sha1(json.dumps(info, sort_keys=True).encode()).hexdigest()[:12]
+    return digest, info
+
+
+# ------------------ Benchmarks ------------------
+
+def run_kernel_bench(args):
+    """Build and run kernel_bench, returning its parsed JSON report."""
+    subprocess.run(["make", "-C", str(NATIVE_DIR), "--quiet"], check=True)
+    cmd = [str(KERNEL_BENCH), "--json", "-", "--repetitions", str(args.repetitions),
+           "--min-time", str(args.min_time)]
+    if args.filter:
+        cmd += ["--filter", args.filter]
+    if args.sizes:
+        cmd += ["--sizes", args.sizes]
+    if args.energy:
+        cmd += ["--energy"]
+    if args.cache_mode:
+        cmd += ["--cache-mode", args.cache_mode]
+    proc = subprocess.run(cmd, check=True, stdout=subprocess.PIPE, text=True)
+    return json.loads(proc.stdout)
+
+
+def by_key(report):
+    """Benchmarks by name/size, with the cache mode appended unless it is steady."""
+    keys = {}
+    for b in report["benchmarks"]:
+        mode = b.get("cache_mode", "steady")
+        keys[f"{b['name']}/{b['size']}" + ("" if mode == "steady" else f"/{mode}")] = b
+    return keys
+
+
+# ------------------ Statistics ------------------
+
+def mann_whitney(x, y):
+    """Two-sided Mann-Whitney U test (normal approximation with tie correction).
+
+    Returns (U of x, p-value).
+    """
+    n1, n2 = len(x), len(y)
+    combined = sorted([(v, 0) for v in x] + [(v, 1) for v in y])
+
+    # Average ranks over ties
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        t = j - i + 1
+        tie_term += t ** 3 - t
+        i = j + 1
+
+    r1 = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    mean_u = n1 * n2 / 2
+    var_u = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0:
+        return u1, 1.0
+    z = (abs(u1 - mean_u) - 0.5) / math.sqrt(var_u)    # continuity correction
+    p = math.erfc(max(z, 0.0) / math.sqrt(2))
+    return u1, min(1.0, p)
+
+
+def cliffs_delta(x, y):
+    """P(x > y) - P(x < y); positive when x (the new run) tends to be larger."""
+    greater = less = 0
+    for a in x:
+        for b in y:
+            if a > b:
+                greater += 1
+            elif a < b:
+                less += 1
+    return (greater - less) / (len(x) * len(y))
+
+
+def median(values):
+    s = sorted(values)
+    mid = len(s) // 2
+    return s[mid] if len(s) % 2 else (s[mid - 1] + s[mid]) / 2
+
+
+def holm(p_values):
+    """Holm-Bonferroni adjusted p-values, in input order."""
+    order = sorted(range(len(p_values)), key=lambda i: p_values[i])
+    adjusted = [0.0] * len(p_values)
+    running = 0.0
+    for rank, i in enumerate(order):
+        running = max(running, min(1.0, (len(p_values) - rank) * p_values[i]))
+        adjusted[i] = running
+    return adjusted
+
+
+def compare_metric(new, old):
+    _, p = mann_whitney(new, old)
+    old_median = median(old)
+    change = (median(new) - old_median) / old_median if old_median else 0.0
+    return {"p": p, "change": change, "cliffs_delta": cliffs_delta(new, old)}
+
+
+# ------------------ Commands ------------------
+
+def baseline_path(args, fingerprint):
+    return Path(args.baseline) if args.baseline else BASELINE_DIR / f"{fingerprint}.json"
+
+
+def record(args):
+    report = json.load(open(args.input)) if args.input else run_kernel_bench(args)
+    fingerprint, info = machine_fingerprint(report)
+    path = baseline_path(args, fingerprint)
+    path.parent.mkdir(parents=True, exist_ok=True)
+    baseline = {
+        "fingerprint": fingerprint,
+        "machine": info,
+        "recorded": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "benchmarks": by_key(report),
+    }
+    with open(path, "w") as f:
+        json.dump(baseline, f, indent=1)
+    print(f"Recorded {len(baseline['benchmarks'])} benchmarks to {path}")
+    return 0
+
+
+def compare(args):
+    report = json.load(open(args.input)) if args.input else run_kernel_bench(args)
+    fingerprint, _ = machine_fingerprint(report)
+    path = baseline_path(args, fingerprint)
+    if not path.exists():
+        print(f"No baseline for this machine and build at {path}; run 'record' first", file=sys.stderr)
+        return 2
+    with open(path) as f:
+        baseline = json.load(f)["benchmarks"]
+
+    current = by_key(report)
+
+    rows = []
+    for key, bench in sorted(current.items()):
+        old = baseline.get(key)
+        if old is None:
+            continue
+        for metric, field in (("time", "samples"), ("energy", "energy_samples")):
+            new_samples, old_samples = bench.get(field) or [], old.get(field) or []
+            if len(new_samples) < 3 or len(old_samples) < 3:
+                continue
+            rows.append(dict(compare_metric(new_samples, old_samples), key=key, metric=metric))
+
+    adjusted = holm([r["p"] for r in rows])
+    regressions = 0
+    print(f"{'benchmark':32s} {'metric':7s} {'change':>9s} {'cliff':>7s} {'p(holm)':>9s}")
+    for row, p_adj in zip(rows, adjusted):
+        significant = p_adj < args.alpha and abs(row["change"]) > args.min_effect
+        status = ""
+        if significant:
+            status = "REGRESSION" if row["change"] > 0 else "improvement"
+            regressions += row["change"] > 0
+        print(f"{row['key']:32s} {row['metric']:7s} {row['change'] * 100:+8.2f}% "
+              f"{row['cliffs_delta']:+7.2f} {p_adj:9.2g}  {status}")
+
+    missing = sorted(set(baseline) - set(current)) if not (args.filter or args.sizes or args.cache_mode) else []
+    for key in missing:
+        print(f"{key:32s} missing from this run")
+
+    print(f"\n{regressions} regression(s) at alpha={args.alpha}, min effect {args.min_effect * 100:.1f}%")
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Record and compare native kernel benchmark baselines.")
+    parser.add_argument("command", choices=["record", "compare"])
+    parser.add_argument("--filter", type=str, default="", help="Only benchmarks whose name contains this")
+    parser.add_argument("--sizes", type=str, default="", help="Override problem sizes (N,M,...)")
+    parser.add_argument("--repetitions", type=int, default=30, help="Samples per benchmark and size")
+    parser.add_argument("--min-time", type=float, default=0.01, help="Minimum duration of one sample")
+    parser.add_argument("--energy", action="store_true", help="Also compare per-call RAPL energy")
+    parser.add_argument("--cache-mode", type=str, default="", help="kernel_bench cache modes (steady, warm, cold, all)")
+    parser.add_argument("--alpha", type=float, default=0.01, help="Family-wise significance level")
+    parser.add_argument("--min-effect", type=float, default=0.03, help="Smallest relative median change to flag")
+    parser.add_argument("--baseline", type=str, default="", help="Baseline file (default: per-machine file)")
+    parser.add_argument("--input", type=str, default="", help="Use an existing kernel_bench JSON instead of running")
+    args = parser.parse_args()
+
+    return record(args) if args.command == "record" else compare(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
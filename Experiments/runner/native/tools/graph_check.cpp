@@ -0,0 +1,282 @@
+// graph_check.cpp
+// Cross-checks the graph kernels of bfs_swig against breadth_first_search()
+// on random graphs: connected_components() on 1..8 threads, directed and
+// undirected; CompressedGraph's decoded lists (1- to 4-byte gaps, with more
+// than 2^24 vertices so the largest gaps need all four bytes), built at once
+// and one list at a time, and its BFS; BoundedBFS depth limits, visit caps
+// and targets; shortest_path() and GraphHandle::shortest_path() lengths and
+// edges. Prints each failure and exits with 1 if there was any.
+//
+//   graph_check [--quick]
+//
+// --quick skips the graph with more than 2^24 vertices (about 250 MB), for
+// the ThreadSanitizer build.
+#include "bfs_swig.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static int failures = 0;
+
+static void fail(const char* what, int a, int b) {
+    if (failures < 20) {
+        std::printf("FAIL %s (%d, %d)\n", what, a, b);
+    }
+    failures++;
+}
+
+// Hop count from s to t along a breadth_first_search() parent map, or -1
+static int bfs_distance(const Graph& graph, int s, int t) {
+    BFSResult result = breadth_first_search(graph, s);
+    if (!result.second.count(t)) {
+        return -1;
+    }
+    int hops = 0;
+    for (int v = t; v != s; v = result.second[v]) {
+        hops++;
+    }
+    return hops;
+}
+
+// Smallest vertex of each vertex's component, by BFS over the undirected view
+static std::vector<int> reference_components(const Graph& graph, bool directed) {
+    Graph undirected = graph;
+    if (directed) {
+        for (Graph::const_iterator it = graph.begin(); it != graph.end(); ++it) {
+            for (size_t i = 0; i < it->second.size(); i++) {
+                undirected[it->second[i]].push_back(it->first);
+            }
+        }
+    }
+    std::map<int, int> label;
+    for (Graph::const_iterator it = undirected.begin(); it != undirected.end(); ++it) {
+        if (label.count(it->first)) {
+            continue;
+        }
+        BFSResult reached = breadth_first_search(undirected, it->first);
+        for (std::map<int, int>::const_iterator p = reached.second.begin(); p != reached.second.end(); ++p) {
+            label[p->first] = it->first;
+        }
+    }
+    std::vector<int> labels;
+    for (Graph::const_iterator it = graph.begin(); it != graph.end(); ++it) {
+        labels.push_back(label[it->first]);
+    }
+    return labels;
+}
+
+static void check_components() {
+    const int sizes[] = {1, 100, 5000, 40000};
+    const int threads[] = {1, 4, 8};
+    for (int directed = 0; directed < 2; directed++) {
+        for (int s = 0; s < 4; s++) {
+            int V = sizes[s];
+            Graph graph = create_sparse_graph(V, V * 6 / 10, directed);
+            std::vector<int> expected = reference_components(graph, directed);
+            for (int t = 0; t < 3; t++) {
+                if (connected_components(graph, threads[t], directed) != expected) {
+                    fail("connected_components V, threads", V, threads[t]);
+                }
+            }
+        }
+    }
+
+    // Keys that are not 0..n-1, and an edge to a vertex that is not a key
+    Graph sparse;
+    sparse[10].push_back(20);
+    sparse[10].push_back(99);
+    sparse[20].push_back(10);
+    sparse[30];
+    sparse[5].push_back(30);
+    std::vector<int> labels = connected_components(sparse, 2);
+    const int expected[] = {5, 10, 10, 5};
+    if (labels.size() != 4 || !std::equal(labels.begin(), labels.end(), expected)) {
+        fail("connected_components on sparse keys", static_cast<int>(labels.size()), 4);
+    }
+}
+
+// Random lists with up to 13 neighbors for the first vertices, a self loop,
+// and an id past the last vertex that the encoder drops
+static void check_compressed_lists(int V) {
+    std::mt19937 rng(V);
+    std::uniform_int_distribution<int> any(0, V - 1);
+    std::uniform_int_distribution<int> degree(0, 13);
+    int checked = std::min(V, 3000);
+    std::vector<long> offsets(V + 1, 0);
+    std::vector<int> targets;
+    for (int v = 0; v < V; v++) {
+        int d = v < checked ? degree(rng) : 0;
+        for (int i = 0; i < d; i++) {
+            targets.push_back(i == 3 ? v : any(rng));
+        }
+        if (v < checked && d > 5) {
+            targets.push_back(V + 5);
+        }
+        offsets[v + 1] = targets.size();
+    }
+
+    CompressedGraph compressed(offsets, targets);
+
+    // The same lists appended one at a time; the vertices past checked are
+    // left to finish()
+    CompressedGraph streamed(V);
+    for (int v = 0; v < checked; v++) {
+        streamed.append_list(targets.data() + offsets[v], offsets[v + 1] - offsets[v]);
+    }
+    streamed.finish();
+    if (streamed.bytes() != compressed.bytes() || streamed.num_edges() != compressed.num_edges()) {
+        fail("CompressedGraph incremental build V, edges", V, static_cast<int>(streamed.num_edges()));
+    }
+
+    for (int v = 0; v < checked; v++) {
+        std::vector<int> expected;
+        for (long e = offsets[v]; e < offsets[v + 1]; e++) {
+            if (targets[e] < V) {
+                expected.push_back(targets[e]);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        if (compressed.neighbors(v) != expected) {
+            fail("CompressedGraph::neighbors V, v", V, v);
+        }
+        if (streamed.neighbors(v) != expected) {
+            fail("CompressedGraph::append_list V, v", V, v);
+        }
+    }
+}
+
+static void check_compressed(bool quick) {
+    const int sizes[] = {1, 7, 1000, 20000000};
+    for (int s = 0; s < (quick ? 3 : 4); s++) {
+        check_compressed_lists(sizes[s]);
+    }
+
+    Graph graph = create_sparse_graph(3000, 5000, false);
+    CompressedGraph compressed(graph);
+    for (int start = 0; start < 20; start++) {
+        int expected = breadth_first_search(graph, start).first;
+        if (compressed.breadth_first_search(start) != expected) {
+            fail("CompressedGraph::breadth_first_search start, expected", start, expected);
+        }
+    }
+}
+
+static void check_bounded() {
+    const int V = 20000;
+    Graph graph = create_sparse_graph(V, 50000, false);
+    BoundedBFS bounded(graph);
+    if (bounded.level(0) != -1) {
+        fail("BoundedBFS::level before a search", bounded.level(0), -1);
+    }
+    for (int s = 0; s < 200; s++) {
+        BFSResult full = breadth_first_search(graph, s);
+        int count = bounded.search(s);
+        if (count != full.first) {
+            fail("BoundedBFS::search count", count, full.first);
+        }
+
+        // Levels agree with the BFS tree
+        std::vector<int> visited = bounded.visited();
+        std::vector<unsigned char> levels = bounded.levels();
+        for (size_t i = 0; i < visited.size(); i++) {
+            int parent = full.second[visited[i]];
+            if (parent >= 0 && bounded.level(parent) + 1 != levels[i]) {
+                fail("BoundedBFS level of vertex", visited[i], levels[i]);
+                break;
+            }
+        }
+
+        // 2-hop neighborhood
+        int within = 0;
+        for (std::map<int, int>::const_iterator it = full.second.begin(); it != full.second.end(); ++it) {
+            int hops = 0;
+            for (int v = it->first; v != s; v = full.second[v]) {
+                hops++;
+            }
+            within += hops <= 2;
+        }
+        int khop = bounded.search(s, 2);
+        if (khop != within) {
+            fail("BoundedBFS::search 2 hops", khop, within);
+        }
+        levels = bounded.levels();
+        if (!levels.empty() && *std::max_element(levels.begin(), levels.end()) > 2) {
+            fail("BoundedBFS::search level past max_depth", s, 2);
+        }
+
+        int capped = bounded.search(s, 255, 10);
+        if (capped > 10) {
+            fail("BoundedBFS::search max_visited", capped, 10);
+        }
+
+        int target = (s * 7919) % V;
+        bounded.search_targets(s, std::vector<int>(1, target));
+        int expected = full.second.count(target) ? target : -1;
+        if (bounded.found() != expected) {
+            fail("BoundedBFS::search_targets found", bounded.found(), expected);
+        }
+    }
+}
+
+static bool is_path(const Graph& graph, const std::vector<int>& path, int s, int t) {
+    if (path.front() != s || path.back() != t) {
+        return false;
+    }
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        const std::vector<int>& adjacent = graph.at(path[i]);
+        if (std::find(adjacent.begin(), adjacent.end(), path[i + 1]) == adjacent.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check_shortest_path() {
+    const int V = 2000;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> any(0, V - 1);
+    for (int directed = 0; directed < 2; directed++) {
+        GraphHandle handle(V, 3000, directed);
+        Graph graph = handle.to_graph();
+        for (int q = 0; q < 300; q++) {
+            int s = any(rng);
+            int t = any(rng);
+            std::vector<int> path = directed ? handle.shortest_path(s, t) : shortest_path(graph, s, t);
+            int hops = bfs_distance(graph, s, t);
+            bool ok = hops < 0 ? path.empty()
+                               : path.size() == static_cast<size_t>(hops) + 1 && is_path(graph, path, s, t);
+            if (!ok) {
+                fail(directed ? "GraphHandle::shortest_path s, t" : "shortest_path s, t", s, t);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--quick]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    check_components();
+    check_compressed(quick);
+    check_bounded();
+    check_shortest_path();
+
+#if defined(__x86_64__) || defined(__i386__)
+    const char* decoder = __builtin_cpu_supports("ssse3") ? "ssse3" : "scalar";
+#else
+    const char* decoder = "scalar";
+#endif
+    std::printf("graph_check: %d failures (CompressedGraph decoder: %s%s)\n", failures, decoder,
+                quick ? ", quick" : "");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+// graph_compress.cpp
+// Compares CompressedGraph (sorted, delta-encoded Stream VByte adjacency)
+// against plain CSR on one random undirected graph: memory footprint and
+// BFS traversal speed from the same start vertices.
+//
+//   graph_compress [--vertices N] [--degree D] [--window W] [--sources S]
+//
+// --window W draws each edge's second end within W ids of the first, as in
+// a graph renumbered for locality; 0 (default) draws it uniformly, which
+// gives the largest gaps and the worst compression.
+#include "bfs_swig.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+struct Csr {
+    std::vector<long> offsets;
+    std::vector<int> targets;
+};
+
+// E = V * degree / 2 undirected edges, stored in both directions
+static Csr random_graph(int V, int degree, int window) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> any(0, V - 1);
+    std::uniform_int_distribution<int> near(-window, window);
+    long E = static_cast<long>(V) * degree / 2;
+
+    std::vector<int> sources(E);
+    std::vector<int> ends(E);
+    for (long e = 0; e < E; e++) {
+        int u = any(rng);
+        int v = window > 0 ? std::min(V - 1, std::max(0, u + near(rng))) : any(rng);
+        sources[e] = u;
+        ends[e] = v;
+    }
+
+    Csr csr;
+    csr.offsets.assign(V + 1, 0);
+    for (long e = 0; e < E; e++) {
+        csr.offsets[sources[e] + 1]++;
+        csr.offsets[ends[e] + 1]++;
+    }
+    for (int v = 0; v < V; v++) {
+        csr.offsets[v + 1] += csr.offsets[v];
+    }
+    std::vector<long> fill(csr.offsets.begin(), csr.offsets.end() - 1);
+    csr.targets.resize(csr.offsets[V]);
+    for (long e = 0; e < E; e++) {
+        csr.targets[fill[sources[e]]++] = ends[e];
+        csr.targets[fill[ends[e]]++] = sources[e];
+    }
+    return csr;
+}
+
+// Same traversal as CompressedGraph::breadth_first_search, reading the
+// neighbor ids directly
+static int csr_bfs(const Csr& csr, int start) {
+    int V = csr.offsets.size() - 1;
+    std::vector<char> visited(V, 0);
+    std::vector<int> queue;
+    queue.push_back(start);
+    visited[start] = 1;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int u = queue[head];
+        for (long e = csr.offsets[u]; e < csr.offsets[u + 1]; e++) {
+            int v = csr.targets[e];
+            if (!visited[v]) {
+                visited[v] = 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    return queue.size();
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return (n % 2) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+int main(int argc, char** argv) {
+    int V = 1000000;
+    int degree = 16;
+    int window = 0;
+    int sources = 5;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--vertices") == 0 && has_value) {
+            V = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--degree") == 0 && has_value) {
+            degree = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--window") == 0 && has_value) {
+            window = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--sources") == 0 && has_value) {
+            sources = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--vertices N] [--degree D] [--window W] [--sources S]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+    if (V < 1 || degree < 0 || window < 0 || sources < 1) {
+        std::fprintf(stderr, "--vertices and --sources must be positive\n");
+        return 2;
+    }
+
+    Csr csr = random_graph(V, degree, window);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CompressedGraph compressed(csr.offsets, csr.targets);
+    double encode_s = seconds_since(start);
+
+    long long csr_bytes = compressed.csr_bytes();
+    long long packed_bytes = compressed.bytes();
+    long edges = compressed.num_edges();
+    std::printf("graph: %d vertices, %ld adjacency entries (window %d)\n", V, edges, window);
+    std::printf("%-12s %14s %12s %12s %12s\n", "format", "bytes", "bytes/edge", "bfs ms", "MTEPS");
+
+    std::mt19937 rng(54321);
+    std::uniform_int_distribution<int> pick(0, V - 1);
+    std::vector<double> csr_s;
+    std::vector<double> packed_s;
+    long reached = 0;
+    for (int s = 0; s < sources; s++) {
+        int source = pick(rng);
+
+        start = std::chrono::steady_clock::now();
+        int csr_visited = csr_bfs(csr, source);
+        csr_s.push_back(seconds_since(start));
+
+        start = std::chrono::steady_clock::now();
+        int packed_visited = compressed.breadth_first_search(source);
+        packed_s.push_back(seconds_since(start));
+
+        if (csr_visited != packed_visited) {
+            std::fprintf(stderr, "visited counts differ from %d: %d (csr) vs %d (compressed)\n",
+                         source, csr_visited, packed_visited);
+            return 1;
+        }
+        reached += csr_visited;
+    }
+
+    // Traversed edges: roughly all entries of the reached vertices
+    double traversed = static_cast<double>(edges) * reached / (static_cast<double>(V) * sources);
+    double csr_median = median(csr_s);
+    double packed_median = median(packed_s);
+    std::printf("%-12s %14lld %12.3f %12.3f %12.1f\n", "csr", csr_bytes,
+                static_cast<double>(csr_bytes) / edges, csr_median * 1e3, traversed / csr_median * 1e-6);
+    std::printf("%-12s %14lld %12.3f %12.3f %12.1f\n", "compressed", packed_bytes,
+                static_cast<double>(packed_bytes) / edges, packed_median * 1e3, traversed / packed_median * 1e-6);
+    std::printf("compression %.2fx, traversal %.2fx of csr, encoded in %.3f s\n",
+                static_cast<double>(csr_bytes) / packed_bytes, csr_median / packed_median, encode_s);
+    return 0;
+}
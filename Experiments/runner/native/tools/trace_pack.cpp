@@ -0,0 +1,64 @@
+// trace_pack.cpp
+// Converts an experiment directory's energibridge.csv traces into one
+// columnar archive, or summarizes an existing archive.
+//
+//   trace_pack <experiment_dir> [out.gltrace]
+//   trace_pack --info <archive.gltrace> [channel]
+#include "trace_archive.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+static int info(const std::string& path, const char* channel) {
+    TraceArchive archive(path);
+    if (!archive.ok()) {
+        std::fprintf(stderr, "%s\n", archive.error().c_str());
+        return 1;
+    }
+
+    std::vector<std::string> names = archive.channel_names();
+    std::printf("%s: %ld runs, %zu channels\n", path.c_str(), archive.run_count(), names.size());
+    if (!channel) {
+        for (size_t c = 0; c < names.size(); c++) {
+            std::printf("  %s\n", names[c].c_str());
+        }
+        return 0;
+    }
+
+    std::vector<double> deltas = archive.channel_deltas(channel);
+    std::vector<double> means = archive.channel_means(channel);
+    std::printf("%-28s %8s %14s %14s\n", "run", "rows", "delta", "mean");
+    for (long i = 0; i < archive.run_count(); i++) {
+        TraceRunInfo run = archive.run_info(static_cast<int>(i));
+        char id[32];
+        std::snprintf(id, sizeof(id), "run_%d_repetition_%d", run.run, run.repetition);
+        std::printf("%-28s %8ld %14.4f %14.4f\n", id, run.rows, deltas[i], means[i]);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "--info") == 0) {
+        return info(argv[2], argc >= 4 ? argv[3] : NULL);
+    }
+    if (argc < 2 || argv[1][0] == '-') {
+        std::fprintf(stderr, "usage: %s <experiment_dir> [out.gltrace]\n"
+                             "       %s --info <archive.gltrace> [channel]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    std::string dir = argv[1];
+    while (dir.size() > 1 && dir[dir.size() - 1] == '/') {
+        dir.erase(dir.size() - 1);
+    }
+    std::string out = argc >= 3 ? argv[2] : dir + "/traces.gltrace";
+
+    CampaignPacker packer(dir);
+    if (!packer.write(out)) {
+        std::fprintf(stderr, "%s\n", packer.error().c_str());
+        return 1;
+    }
+    std::printf("Packed %ld runs into %s\n", packer.runs(), out.c_str());
+    return 0;
+}
@@ -0,0 +1,232 @@
+// kernel_async.cpp
+#include "kernel_async.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+KernelCallState::KernelCallState()
+    : event_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      status(PENDING), cancel_requested(false), progress_permille(0) {}
+
+KernelCallState::~KernelCallState() {
+    if (event_fd >= 0) {
+        close(event_fd);
+    }
+}
+
+void KernelCallState::signal() {
+    if (event_fd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(event_fd, &one, sizeof(one));
+        (void)written;  // only fails when the counter would overflow, still readable then
+    }
+}
+
+void KernelCallState::finish(Status final_status, const std::string& message) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        error = message;
+        status = final_status;
+    }
+    finished.notify_all();
+    signal();
+}
+
+bool KernelCallState::start() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (status != PENDING) {
+        return false;
+    }
+    status = RUNNING;
+    return true;
+}
+
+bool KernelCallState::cancel_pending() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (status != PENDING) {
+            return false;
+        }
+        status = CANCELLED;
+    }
+    finished.notify_all();
+    signal();
+    return true;
+}
+
+bool KernelProgress::update(double fraction) {
+    if (!state) {
+        return true;
+    }
+    int permille = static_cast<int>(fraction * 1000.0);
+    permille = permille < 0 ? 0 : permille > 1000 ? 1000 : permille;
+    // Signal at most once per percent
+    int previous = state->progress_permille.exchange(permille);
+    if (permille / 10 != previous / 10) {
+        state->signal();
+    }
+    return !state->cancel_requested;
+}
+
+bool KernelProgress::cancelled() const {
+    return state && state->cancel_requested;
+}
+
+KernelFuture::KernelFuture(const std::shared_ptr<KernelCallState>& state) : state(state) {}
+
+KernelFuture::~KernelFuture() {}
+
+int KernelFuture::fileno() const {
+    return state->event_fd;
+}
+
+void KernelFuture::clear_events() {
+    uint64_t count;
+    ssize_t got = read(state->event_fd, &count, sizeof(count));
+    (void)got;  // EAGAIN when nothing was pending
+}
+
+bool KernelFuture::done() const {
+    return state->status >= KernelCallState::DONE;
+}
+
+bool KernelFuture::cancelled() const {
+    return state->status == KernelCallState::CANCELLED;
+}
+
+bool KernelFuture::failed() const {
+    return state->status == KernelCallState::FAILED;
+}
+
+std::string KernelFuture::error() const {
+    std::lock_guard<std::mutex> guard(state->lock);
+    return state->error;
+}
+
+double KernelFuture::progress() const {
+    return state->progress_permille / 1000.0;
+}
+
+void KernelFuture::check_done() const {
+    switch (state->status) {
+    case KernelCallState::DONE:
+        return;
+    case KernelCallState::FAILED:
+        throw std::runtime_error("kernel call failed: " + error());
+    case KernelCallState::CANCELLED:
+        throw std::runtime_error("kernel call was cancelled");
+    default:
+        throw std::runtime_error("kernel call has not finished");
+    }
+}
+
+bool KernelFuture::cancel() {
+    if (done()) {
+        return false;
+    }
+    state->cancel_requested = true;
+    state->cancel_pending();
+    return true;
+}
+
+bool KernelFuture::wait(double timeout_s) {
+    std::unique_lock<std::mutex> guard(state->lock);
+    KernelCallState* s = state.get();
+    if (timeout_s < 0) {
+        s->finished.wait(guard, [s]() { return s->status >= KernelCallState::DONE; });
+        return true;
+    }
+    return s->finished.wait_for(guard, std::chrono::duration<double>(timeout_s),
+                                [s]() { return s->status >= KernelCallState::DONE; });
+}
+
+// Fixed-size pool; tasks run in submission order
+class KernelPool {
+    struct QueuedTask {
+        std::shared_ptr<KernelCallState> state;
+        std::function<void()> run;
+    };
+
+
+public:
+    KernelPool() : stopping(false) {
+        unsigned n = std::thread::hardware_concurrency();
+        running.resize(n ? n : 1);
+        for (unsigned t = 0; t < running.size(); t++) {
+            threads.push_back(std::thread(&KernelPool::run, this, t));
+        }
+    }
+
+    ~KernelPool() {
+        std::deque<QueuedTask> dropped;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+            dropped.swap(tasks);
+            // Running kernels stop at their next progress update, so the
+            // joins below do not wait for whole calls
+            for (size_t t = 0; t < running.size(); t++) {
+                if (running[t]) {
+                    running[t]->cancel_requested = true;
+                }
+            }
+        }
+        ready.notify_all();
+        // Calls that never started complete as cancelled, so no future waits
+        // forever
+        for (size_t t = 0; t < dropped.size(); t++) {
+            dropped[t].state->cancel_pending();
+        }
+        for (size_t t = 0; t < threads.size(); t++) {
+            threads[t].join();
+        }
+    }
+
+    void submit(const std::shared_ptr<KernelCallState>& state, const std::function<void()>& task) {
+        QueuedTask queued = {state, task};
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(queued);
+        }
+        ready.notify_one();
+    }
+
+private:
+    KernelPool(const KernelPool&);
+    KernelPool& operator=(const KernelPool&);
+
+    void run(unsigned index) {
+        std::function<void()> task;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                running[index].reset();
+                ready.wait(guard, [this]() { return stopping || !tasks.empty(); });
+                if (stopping) {
+                    return;
+                }
+                running[index] = tasks.front().state;
+                task = tasks.front().run;
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque<QueuedTask> tasks;
+    std::vector<std::shared_ptr<KernelCallState> > running;    // by thread, NULL when idle
+    std::vector<std::thread> threads;
+    bool stopping;
+};
+
+void kernel_pool_submit(const std::shared_ptr<KernelCallState>& state, const std::function<void()>& task) {
+    static KernelPool pool;
+    pool.submit(state, task);
+}
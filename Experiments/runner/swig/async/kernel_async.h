@@ -0,0 +1,150 @@
+// kernel_async.h
+#ifndef KERNEL_ASYNC_H
+#define KERNEL_ASYNC_H
+
+#include <stdexcept>
+#include <string>
+
+#ifndef SWIG
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// Shared state of one asynchronous kernel call, between its future and the
+// pool thread running it
+struct KernelCallState {
+    enum Status { PENDING, RUNNING, DONE, FAILED, CANCELLED };
+
+    KernelCallState();
+    ~KernelCallState();
+
+    // Wakes up whoever polls the eventfd (progress or completion)
+    void signal();
+    void finish(Status final_status, const std::string& message = "");
+
+    // PENDING -> RUNNING; false if the call was cancelled before it started
+    bool start();
+    // Finishes a call that has not started as CANCELLED; false once it runs
+    bool cancel_pending();
+
+    int event_fd;
+    std::atomic<int> status;
+    std::atomic<bool> cancel_requested;
+    std::atomic<int> progress_permille;
+    std::mutex lock;
+    std::condition_variable finished;
+    std::string error;
+};
+
+// Handed to a kernel running asynchronously (NULL state for plain calls)
+class KernelProgress {
+public:
+    explicit KernelProgress(KernelCallState* state = NULL) : state(state) {}
+
+    // Publishes the fraction done (0..1); false once cancel() was called, in
+    // which case the kernel should return early
+    bool update(double fraction);
+
+    bool cancelled() const;
+
+private:
+    KernelCallState* state;
+};
+#endif
+
+// Result-independent part of a kernel future. fileno() is an eventfd that
+// becomes readable whenever the progress advances by 1% and when the call
+// finishes, fails or is cancelled, so an asyncio loop can add_reader() it
+// (see kernel_async.py) instead of blocking a thread.
+class KernelFuture {
+public:
+    virtual ~KernelFuture();
+
+    int fileno() const;
+
+    // Drains the eventfd after a wake-up
+    void clear_events();
+
+    bool done() const;          // finished, failed or cancelled
+    bool cancelled() const;
+    bool failed() const;
+    std::string error() const;
+    double progress() const;    // 0..1
+
+    // Drops the call if it has not started, so it is cancelled at once, or
+    // asks the running kernel to stop at its next progress update. False if
+    // it already finished.
+    bool cancel();
+
+    // Blocks until done(); timeout_s < 0 waits forever. True if done.
+    bool wait(double timeout_s = -1.0);
+
+#ifndef SWIG
+protected:
+    explicit KernelFuture(const std::shared_ptr<KernelCallState>& state);
+
+    // Throws std::runtime_error unless the call finished successfully
+    void check_done() const;
+
+    std::shared_ptr<KernelCallState> state;
+#endif
+};
+
+// Future of a kernel returning T
+template <typename T>
+class KernelResultFuture : public KernelFuture {
+public:
+    // The kernel's return value. Throws std::runtime_error if the call is
+    // still pending or running, failed or was cancelled (RuntimeError in Python)
+    T result() const {
+        check_done();
+        return *value;
+    }
+
+#ifndef SWIG
+    KernelResultFuture(const std::shared_ptr<KernelCallState>& state, const std::shared_ptr<T>& value)
+        : KernelFuture(state), value(value) {}
+
+private:
+    std::shared_ptr<T> value;
+#endif
+};
+
+#ifndef SWIG
+// Queues a task on the process-wide kernel thread pool (one thread per CPU,
+// started on first use). A task still queued when the pool shuts down does
+// not run; its state is finished as CANCELLED instead. A task cancelled
+// while queued is skipped.
+void kernel_pool_submit(const std::shared_ptr<KernelCallState>& state, const std::function<void()>& task);
+
+// Runs call(progress) on the kernel pool. The caller owns the returned future.
+template <typename T>
+KernelResultFuture<T>* submit_kernel(const std::function<T(KernelProgress&)>& call) {
+    std::shared_ptr<KernelCallState> state(new KernelCallState());
+    std::shared_ptr<T> value(new T());
+    kernel_pool_submit(state, [state, value, call]() {
+        if (!state->start()) {
+            return;     // cancelled while queued, already finished
+        }
+        KernelProgress progress(state.get());
+        try {
+            T result = call(progress);
+            if (progress.cancelled()) {
+                state->finish(KernelCallState::CANCELLED);
+                return;
+            }
+            value->swap(result);
+            state->progress_permille = 1000;
+            state->finish(KernelCallState::DONE);
+        } catch (const std::exception& e) {
+            state->finish(KernelCallState::FAILED, e.what());
+        }
+    });
+    return new KernelResultFuture<T>(state, value);
+}
+#endif
+
+#endif // KERNEL_ASYNC_H
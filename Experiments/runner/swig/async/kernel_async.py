@@ -0,0 +1,53 @@
+"""
+asyncio integration for the asynchronous SWIG kernels.
+
+The *_async() kernels (matmul_swig.matmul_blocked_async,
+nbody_swig.nbody_step_update_async) queue the call on a native thread pool and
+return a future at once. Its fileno() is an eventfd that becomes readable on
+every 1% of progress and when the call ends, so the event loop watches it with
+add_reader() and keeps serving other I/O while the kernel runs:
+
+    future = matmul_swig.matmul_blocked_async(A, B)
+    C = await kernel_result(future, on_progress=lambda p: print(f"{p:.0%}"))
+
+Cancelling the awaiting task cancels the native call: a queued call is dropped
+and a running kernel stops at its next progress update.
+"""
+import asyncio
+
+
+async def kernel_result(future, on_progress=None):
+    """Wait for a native kernel future without blocking the loop and return its result.
+
+    on_progress(fraction) runs on the loop thread whenever the progress changed.
+    Raises asyncio.CancelledError if the call was cancelled and RuntimeError if it failed.
+    """
+    loop = asyncio.get_running_loop()
+    finished = loop.create_future()
+    fd = future.fileno()
+    last_progress = -1.0
+
+    def on_event():
+        nonlocal last_progress
+        future.clear_events()
+        progress = future.progress()
+        if on_progress is not None and progress != last_progress:
+            last_progress = progress
+            on_progress(progress)
+        if future.done() and not finished.done():
+            finished.set_result(None)
+
+    loop.add_reader(fd, on_event)
+    try:
+        await finished
+    except asyncio.CancelledError:
+        future.cancel()
+        raise
+    finally:
+        loop.remove_reader(fd)
+
+    if future.cancelled():
+        raise asyncio.CancelledError()
+    if future.failed():
+        raise RuntimeError(future.error())
+    return future.result()
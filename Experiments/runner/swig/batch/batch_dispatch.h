@@ -0,0 +1,48 @@
+// batch_dispatch.h
+// Batched kernel calls for the SWIG modules. Python passes the arguments of
+// N calls packed into one flat array, the module runs the kernel N times in
+// C++ and hands back the results packed into one buffer, so the SWIG
+// dispatch and conversions are paid once per batch instead of once per call.
+//
+// This is a loop helper, not a general command buffer: one batch runs one
+// kernel, every call takes the same number of arguments of one type, the
+// calls run in order on the calling thread, and a kernel cannot report an
+// error for a single call.
+#ifndef BATCH_DISPATCH_H
+#define BATCH_DISPATCH_H
+
+#include <cstddef>
+#include <vector>
+
+// Number of calls packed in args, arity values per call (trailing values
+// that do not fill a whole call are ignored)
+template <typename Arg>
+inline size_t batch_calls(const std::vector<Arg>& args, size_t arity) {
+    return arity ? args.size() / arity : 0;
+}
+
+// Calls kernel(call_args) with a pointer to each call's arity arguments
+// and returns the results in call order
+template <typename Arg, typename Kernel>
+auto dispatch_batch(const std::vector<Arg>& args, size_t arity, Kernel kernel)
+    -> std::vector<decltype(kernel(args.data()))> {
+    size_t n = batch_calls(args, arity);
+    std::vector<decltype(kernel(args.data()))> results;
+    results.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        results.push_back(kernel(args.data() + i * arity));
+    }
+    return results;
+}
+
+// For kernels with variable-size results: kernel(call_args, out) appends
+// each call's result to the one packed buffer out (a std::string or vector)
+template <typename Arg, typename Packed, typename Kernel>
+void dispatch_batch_packed(const std::vector<Arg>& args, size_t arity, Packed& out, Kernel kernel) {
+    size_t n = batch_calls(args, arity);
+    for (size_t i = 0; i < n; i++) {
+        kernel(args.data() + i * arity, out);
+    }
+}
+
+#endif // BATCH_DISPATCH_H
@@ -1,12 +1,23 @@
 // bfs_swig.cpp
 #include "bfs_swig.h"
+#include "kernel_trace.h"
+#include "batch_dispatch.h"
 #include <queue>
 #include <set>
+#include <unordered_map>
 #include <cstdlib>
 #include <ctime>
 #include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#endif
 
 BFSResult breadth_first_search(const Graph& graph, int start_node) {
+    KERNEL_TRACE_SPAN("breadth_first_search");
     std::map<int, int> path;
     
     if (graph.find(start_node) == graph.end()) {
@@ -39,6 +50,285 @@ BFSResult breadth_first_search(const Graph& graph, int start_node) {
     return BFSResult(visited.size(), path);
 }
 
+std::vector<int> breadth_first_search_batch(const Graph& graph, const std::vector<int>& start_nodes) {
+    return dispatch_batch(start_nodes, 1, [&graph](const int* start) {
+        return breadth_first_search(graph, *start).first;
+    });
+}
+
+// Expands every vertex of one side's frontier by one level, recording
+// parents in own. Stops as soon as it reaches a vertex the other side has
+// seen and returns true with that vertex in meet; otherwise frontier becomes
+// the next level.
+static bool expand_level(const Graph& adjacency, std::vector<int>& frontier,
+                         std::unordered_map<int, int>& own,
+                         const std::unordered_map<int, int>& other, int& meet) {
+    std::vector<int> next;
+    for (int u : frontier) {
+        auto it = adjacency.find(u);
+        if (it == adjacency.end()) {
+            continue;
+        }
+        for (int v : it->second) {
+            if (!own.insert(std::make_pair(v, u)).second) {
+                continue;
+            }
+            if (other.find(v) != other.end()) {
+                meet = v;
+                return true;
+            }
+            next.push_back(v);
+        }
+    }
+    frontier.swap(next);
+    return false;
+}
+
+// shortest_path() with separate out-edge and in-edge lists (the same graph
+// twice when undirected)
+static std::vector<int> bidirectional_path(const Graph& forward, const Graph& backward, int s, int t) {
+    KERNEL_TRACE_SPAN("shortest_path");
+    std::vector<int> path;
+
+    if (forward.find(s) == forward.end() || forward.find(t) == forward.end()) {
+        return path;
+    }
+    if (s == t) {
+        path.push_back(s);
+        return path;
+    }
+
+    // Parents towards s and towards t; -1 marks the two ends
+    std::unordered_map<int, int> from_s;
+    std::unordered_map<int, int> from_t;
+    from_s[s] = -1;
+    from_t[t] = -1;
+    std::vector<int> frontier_s(1, s);
+    std::vector<int> frontier_t(1, t);
+
+    // Both sides are expanded a whole level at a time, so every vertex
+    // within the searched depths is known and the first meeting already
+    // lies on a shortest path
+    int meet = 0;
+    bool found = false;
+    while (!found && !frontier_s.empty() && !frontier_t.empty()) {
+        if (frontier_s.size() <= frontier_t.size()) {
+            found = expand_level(forward, frontier_s, from_s, from_t, meet);
+        } else {
+            found = expand_level(backward, frontier_t, from_t, from_s, meet);
+        }
+    }
+    if (!found) {
+        return path;
+    }
+
+    for (int v = meet; v != s; v = from_s[v]) {
+        path.push_back(v);
+    }
+    path.push_back(s);
+    std::reverse(path.begin(), path.end());
+    for (int v = meet; v != t; ) {
+        v = from_t[v];
+        path.push_back(v);
+    }
+    return path;
+}
+
+std::vector<int> shortest_path(const Graph& graph, int s, int t) {
+    return bidirectional_path(graph, graph, s, t);
+}
+
+// Neighbors sampled per vertex before the largest component is picked
+static const int AFFOREST_ROUNDS = 2;
+static const int AFFOREST_SAMPLES = 1024;
+static const int AFFOREST_CHUNK = 4096;
+
+// Graph as compressed rows over dense indices 0..n-1 (the key order)
+struct DenseGraph {
+    std::vector<int> keys;
+    std::vector<long> offsets;
+    std::vector<int> targets;
+};
+
+static DenseGraph dense_graph(const Graph& graph) {
+    DenseGraph dense;
+    dense.keys.reserve(graph.size());
+    for (const auto& entry : graph) {
+        dense.keys.push_back(entry.first);
+    }
+
+    // create_sparse_graph keys are already 0..n-1
+    int n = dense.keys.size();
+    bool identity = n == 0 || (dense.keys.front() == 0 && dense.keys.back() == n - 1);
+    std::unordered_map<int, int> index;
+    if (!identity) {
+        for (int i = 0; i < n; i++) {
+            index[dense.keys[i]] = i;
+        }
+    }
+
+    dense.offsets.reserve(n + 1);
+    dense.offsets.push_back(0);
+    for (const auto& entry : graph) {
+        for (int v : entry.second) {
+            if (identity) {
+                if (v >= 0 && v < n) {
+                    dense.targets.push_back(v);
+                }
+            } else {
+                auto it = index.find(v);
+                if (it != index.end()) {
+                    dense.targets.push_back(it->second);
+                }
+            }
+        }
+        dense.offsets.push_back(dense.targets.size());
+    }
+    return dense;
+}
+
+// Runs body(begin, end) over [0, n) in chunks handed out to threads threads;
+// the calling thread is one of them
+template <class Body>
+static void parallel_chunks(int n, int threads, const Body& body) {
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        for (int begin = next.fetch_add(AFFOREST_CHUNK); begin < n; begin = next.fetch_add(AFFOREST_CHUNK)) {
+            body(begin, std::min(n, begin + AFFOREST_CHUNK));
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) {
+        workers.push_back(std::thread(work));
+    }
+    work();
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+}
+
+// Joins the trees of u and v, always hanging the larger root under the
+// smaller, so a root is the smallest index of its tree. Lock-free: a root is
+// only replaced by compare-and-swap, and a lost race retries from the new
+// parents.
+static void link(int u, int v, std::vector<std::atomic<int> >& comp) {
+    int p1 = comp[u].load(std::memory_order_relaxed);
+    int p2 = comp[v].load(std::memory_order_relaxed);
+    while (p1 != p2) {
+        int high = std::max(p1, p2);
+        int low = std::min(p1, p2);
+        int p_high = comp[high].load(std::memory_order_relaxed);
+        if (p_high == low) {
+            break;
+        }
+        if (p_high == high && comp[high].compare_exchange_strong(p_high, low)) {
+            break;
+        }
+        p1 = comp[comp[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+        p2 = comp[low].load(std::memory_order_relaxed);
+    }
+}
+
+// Points every vertex directly at its root
+static void compress(std::vector<std::atomic<int> >& comp, int threads) {
+    int n = comp.size();
+    parallel_chunks(n, threads, [&comp](int begin, int end) {
+        for (int v = begin; v < end; v++) {
+            int parent = comp[v].load(std::memory_order_relaxed);
+            int grandparent = comp[parent].load(std::memory_order_relaxed);
+            while (parent != grandparent) {
+                comp[v].store(grandparent, std::memory_order_relaxed);
+                parent = grandparent;
+                grandparent = comp[parent].load(std::memory_order_relaxed);
+            }
+        }
+    });
+}
+
+// Root of the largest component, estimated from a fixed random sample
+static int most_frequent_root(const std::vector<std::atomic<int> >& comp) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> pick(0, comp.size() - 1);
+    std::unordered_map<int, int> counts;
+    int best = comp[0].load(std::memory_order_relaxed);
+    int best_count = 0;
+    for (int s = 0; s < AFFOREST_SAMPLES; s++) {
+        int root = comp[pick(rng)].load(std::memory_order_relaxed);
+        int count = ++counts[root];
+        if (count > best_count) {
+            best = root;
+            best_count = count;
+        }
+    }
+    return best;
+}
+
+std::vector<int> connected_components(const Graph& graph, int threads, bool directed) {
+    KERNEL_TRACE_SPAN("connected_components");
+    DenseGraph dense = dense_graph(graph);
+    int n = dense.keys.size();
+    std::vector<int> labels(n);
+    if (n == 0) {
+        return labels;
+    }
+
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max(1, n / AFFOREST_CHUNK));
+
+    std::vector<std::atomic<int> > comp(n);
+    for (int v = 0; v < n; v++) {
+        comp[v].store(v, std::memory_order_relaxed);
+    }
+
+    // Sampled neighbors usually join most of the giant component already
+    for (int r = 0; r < AFFOREST_ROUNDS; r++) {
+        parallel_chunks(n, threads, [&dense, &comp, r](int begin, int end) {
+            for (int u = begin; u < end; u++) {
+                long e = dense.offsets[u] + r;
+                if (e < dense.offsets[u + 1]) {
+                    link(u, dense.targets[e], comp);
+                }
+            }
+        });
+        compress(comp, threads);
+    }
+
+    // Remaining edges. A vertex already in the largest component can be
+    // skipped: in an undirected graph each of its edges to another
+    // component is also linked from the other end.
+    int giant = directed ? -1 : most_frequent_root(comp);
+    parallel_chunks(n, threads, [&dense, &comp, giant](int begin, int end) {
+        for (int u = begin; u < end; u++) {
+            if (comp[u].load(std::memory_order_relaxed) == giant) {
+                continue;
+            }
+            for (long e = dense.offsets[u] + AFFOREST_ROUNDS; e < dense.offsets[u + 1]; e++) {
+                link(u, dense.targets[e], comp);
+            }
+        }
+    });
+    compress(comp, threads);
+
+    for (int v = 0; v < n; v++) {
+        labels[v] = dense.keys[comp[v].load(std::memory_order_relaxed)];
+    }
+    return labels;
+}
+
+// In-edge lists of a directed graph; every vertex of graph gets an entry
+static Graph reverse_edges(const Graph& graph) {
+    Graph reversed;
+    for (const auto& entry : graph) {
+        reversed[entry.first];
+        for (int v : entry.second) {
+            reversed[v].push_back(entry.first);
+        }
+    }
+    return reversed;
+}
+
 Graph create_sparse_graph(int V, int E, bool directed) {
     Graph adj;
     
@@ -51,9 +341,10 @@ Graph create_sparse_graph(int V, int E, bool directed) {
         adj[i] = std::vector<int>();
     }
     
-    int max_edges = V * (V - 1) / 2;
+    // In 64 bits: V * (V - 1) overflows an int from V = 46342
+    long long max_edges = static_cast<long long>(V) * (V - 1) / 2;
     if (E > max_edges) {
-        E = max_edges;
+        E = static_cast<int>(max_edges);
     }
     
     std::set<std::pair<int, int>> edges;
@@ -86,4 +377,394 @@ Graph create_sparse_graph(int V, int E, bool directed) {
     }
     
     return adj;
-}
\ No newline at end of file
+}
+
+GraphHandle::GraphHandle(int V, int E, bool directed)
+    : adjacency(create_sparse_graph(V, E, directed)),
+      reversed(directed ? reverse_edges(adjacency) : Graph()),
+      directed(directed) {}
+
+GraphHandle::GraphHandle(const Graph& graph, bool directed)
+    : adjacency(graph),
+      reversed(directed ? reverse_edges(adjacency) : Graph()),
+      directed(directed) {}
+
+int GraphHandle::num_vertices() const {
+    return adjacency.size();
+}
+
+int GraphHandle::breadth_first_search(int start_node) {
+    BFSResult result = ::breadth_first_search(adjacency, start_node);
+    last_parents.swap(result.second);
+    return result.first;
+}
+
+std::vector<int> GraphHandle::breadth_first_search_batch(const std::vector<int>& start_nodes) const {
+    return ::breadth_first_search_batch(adjacency, start_nodes);
+}
+
+std::vector<int> GraphHandle::shortest_path(int s, int t) const {
+    return bidirectional_path(adjacency, directed ? reversed : adjacency, s, t);
+}
+
+std::vector<int> GraphHandle::connected_components(int threads) const {
+    return ::connected_components(adjacency, threads, directed);
+}
+
+std::map<int, int> GraphHandle::parents() const {
+    return last_parents;
+}
+
+Graph GraphHandle::to_graph() const {
+    return adjacency;
+}
+
+const Graph& GraphHandle::graph() const {
+    return adjacency;
+}
+
+// Stream VByte: 4 gaps per control byte, gap j's byte count - 1 in bits 2j
+static int gap_bytes(unsigned int gap) {
+    return gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+}
+
+// Per control byte: the data bytes of its group of four gaps, and the
+// pshufb mask spreading those bytes into four 32-bit lanes
+struct GroupTables {
+    unsigned char lengths[256];
+    alignas(16) unsigned char shuffles[256][16];
+
+    GroupTables() {
+        for (int c = 0; c < 256; c++) {
+            int source = 0;
+            for (int lane = 0; lane < 4; lane++) {
+                int length = ((c >> (2 * lane)) & 3) + 1;
+                for (int b = 0; b < 4; b++) {
+                    shuffles[c][4 * lane + b] = b < length ? static_cast<unsigned char>(source++) : 0x80;
+                }
+            }
+            lengths[c] = static_cast<unsigned char>(source);
+        }
+    }
+};
+
+static const GroupTables& group_tables() {
+    static const GroupTables tables;
+    return tables;
+}
+
+CompressedGraph::CompressedGraph(const Graph& graph)
+    : vertices(graph.size()), edges(0), max_degree(0), appended(0), finished(false),
+      list_offsets(graph.size() + 1, 0) {
+    DenseGraph dense = dense_graph(graph);
+    KERNEL_TRACE_SPAN("compress_graph");
+    for (int v = 0; v < vertices; v++) {
+        append_list(dense.targets.data() + dense.offsets[v], dense.offsets[v + 1] - dense.offsets[v]);
+    }
+    finish();
+}
+
+CompressedGraph::CompressedGraph(const std::vector<long>& offsets, const std::vector<int>& targets)
+    : vertices(offsets.empty() ? 0 : offsets.size() - 1), edges(0), max_degree(0), appended(0),
+      finished(false), list_offsets(vertices + 1, 0) {
+    KERNEL_TRACE_SPAN("compress_graph");
+    for (int v = 0; v < vertices; v++) {
+        append_list(targets.data() + offsets[v], offsets[v + 1] - offsets[v]);
+    }
+    finish();
+}
+
+CompressedGraph::CompressedGraph(int num_vertices)
+    : vertices(std::max(0, num_vertices)), edges(0), max_degree(0), appended(0), finished(false),
+      list_offsets(vertices + 1, 0) {}
+
+bool CompressedGraph::append_list(const int* neighbors, int count) {
+    if (finished || appended == vertices) {
+        return false;
+    }
+
+    // Ids outside 0..n-1 are not vertices of this graph
+    scratch.clear();
+    for (int i = 0; i < count; i++) {
+        if (neighbors[i] >= 0 && neighbors[i] < vertices) {
+            scratch.push_back(neighbors[i]);
+        }
+    }
+    std::sort(scratch.begin(), scratch.end());
+    int degree = scratch.size();
+    edges += degree;
+    max_degree = std::max(max_degree, degree);
+    list_offsets[appended++] = stream.size();
+
+    for (unsigned int d = degree; ; d >>= 7) {
+        if (d < 0x80) {
+            stream.push_back(static_cast<unsigned char>(d));
+            break;
+        }
+        stream.push_back(static_cast<unsigned char>(0x80 | (d & 0x7f)));
+    }
+
+    size_t control = stream.size();
+    stream.resize(control + (degree + 3) / 4, 0);
+    int previous = 0;
+    for (int i = 0; i < degree; i++) {
+        unsigned int gap = static_cast<unsigned int>(scratch[i] - previous);
+        previous = scratch[i];
+        int length = gap_bytes(gap);
+        stream[control + i / 4] |= static_cast<unsigned char>((length - 1) << (2 * (i % 4)));
+        for (int b = 0; b < length; b++) {
+            stream.push_back(static_cast<unsigned char>(gap >> (8 * b)));
+        }
+    }
+    return true;
+}
+
+void CompressedGraph::finish() {
+    if (finished) {
+        return;
+    }
+    while (appended < vertices) {
+        append_list(NULL, 0);
+    }
+    list_offsets[vertices] = stream.size();
+
+    // The SIMD decoder loads 16 bytes per group, past the end of the last list
+    stream.resize(stream.size() + 16, 0);
+    stream.shrink_to_fit();
+    std::vector<int>().swap(scratch);
+    finished = true;
+}
+
+// Gaps starting at data, by the codes of control; adds them up from base
+static void decode_gaps_scalar(const unsigned char* control, const unsigned char* data, int count,
+                               int base, int* out) {
+    for (int i = 0; i < count; i++) {
+        int length = ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        unsigned int gap = 0;
+        for (int b = 0; b < length; b++) {
+            gap |= static_cast<unsigned int>(data[b]) << (8 * b);
+        }
+        data += length;
+        base += gap;
+        out[i] = base;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("ssse3")))
+static void decode_gaps_ssse3(const unsigned char* control, const unsigned char* data, int count, int* out) {
+    const GroupTables& tables = group_tables();
+    __m128i base = _mm_setzero_si128();
+    int groups = count / 4;
+    for (int g = 0; g < groups; g++) {
+        unsigned char c = control[g];
+        __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.shuffles[c]));
+        __m128i gaps = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), shuffle);
+        // Prefix sum over the four lanes, plus the last value of the previous group
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+        __m128i values = _mm_add_epi32(gaps, base);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * g), values);
+        base = _mm_shuffle_epi32(values, 0xff);
+        data += tables.lengths[c];
+    }
+    int done = 4 * groups;
+    decode_gaps_scalar(control + groups, data, count - done, done ? out[done - 1] : 0, out + done);
+}
+
+static bool have_ssse3() {
+    static bool ssse3 = __builtin_cpu_supports("ssse3");
+    return ssse3;
+}
+#endif
+
+// Writes the neighbors of v to out (room for max_degree values) and returns
+// how many there are
+int CompressedGraph::decode(int v, int* out) const {
+    const unsigned char* p = stream.data() + list_offsets[v];
+    unsigned int degree = 0;
+    for (int shift = 0; ; shift += 7) {
+        unsigned char byte = *p++;
+        degree |= static_cast<unsigned int>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    int count = degree;
+    const unsigned char* control = p;
+    const unsigned char* data = p + (count + 3) / 4;
+#if defined(__x86_64__) || defined(__i386__)
+    if (have_ssse3()) {
+        decode_gaps_ssse3(control, data, count, out);
+        return count;
+    }
+#endif
+    decode_gaps_scalar(control, data, count, 0, out);
+    return count;
+}
+
+int CompressedGraph::num_vertices() const {
+    return vertices;
+}
+
+long CompressedGraph::num_edges() const {
+    return edges;
+}
+
+long long CompressedGraph::bytes() const {
+    return static_cast<long long>(stream.size()) + list_offsets.size() * sizeof(size_t);
+}
+
+long long CompressedGraph::csr_bytes() const {
+    return static_cast<long long>(vertices + 1) * sizeof(long) + static_cast<long long>(edges) * sizeof(int);
+}
+
+std::vector<int> CompressedGraph::neighbors(int v) const {
+    std::vector<int> out;
+    if (!finished || v < 0 || v >= vertices) {
+        return out;
+    }
+    out.resize(max_degree);
+    out.resize(decode(v, out.data()));
+    return out;
+}
+
+int CompressedGraph::breadth_first_search(int start) const {
+    KERNEL_TRACE_SPAN("compressed_bfs");
+    if (!finished || start < 0 || start >= vertices) {
+        return 0;
+    }
+
+    std::vector<char> visited(vertices, 0);
+    std::vector<int> queue;
+    std::vector<int> buffer(max_degree);
+
+    queue.push_back(start);
+    visited[start] = 1;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int degree = decode(queue[head], buffer.data());
+        for (int i = 0; i < degree; i++) {
+            int v = buffer[i];
+            if (!visited[v]) {
+                visited[v] = 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    return queue.size();
+}
+
+BoundedBFS::BoundedBFS(const Graph& graph) : epoch(0), target_found(-1) {
+    DenseGraph dense = dense_graph(graph);
+    edge_offsets.swap(dense.offsets);
+    edge_targets.swap(dense.targets);
+    int n = edge_offsets.size() - 1;
+    seen.assign(n, 0);
+    wanted.assign(n, 0);
+    depth.assign(n, 0);
+}
+
+int BoundedBFS::num_vertices() const {
+    return seen.size();
+}
+
+void BoundedBFS::next_epoch() {
+    // On wrap-around stale stamps could match again; clear them once per
+    // 2^32 queries
+    if (++epoch == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        std::fill(wanted.begin(), wanted.end(), 0);
+        epoch = 1;
+    }
+}
+
+template <class IsTarget>
+int BoundedBFS::run(int start, const IsTarget& is_target, int max_depth, int max_visited) {
+    KERNEL_TRACE_SPAN("bounded_bfs");
+    order.clear();
+    order_levels.clear();
+    target_found = -1;
+    if (start < 0 || start >= num_vertices()) {
+        return 0;
+    }
+    max_depth = std::max(0, std::min(max_depth, 255));
+    size_t cap = max_visited > 0 ? static_cast<size_t>(max_visited) : seen.size();
+
+    seen[start] = epoch;
+    depth[start] = 0;
+    order.push_back(start);
+    order_levels.push_back(0);
+    if (is_target(start)) {
+        target_found = start;
+        return order.size();
+    }
+
+    for (size_t head = 0; head < order.size(); head++) {
+        int u = order[head];
+        int d = depth[u];
+        if (d >= max_depth) {
+            // BFS order: every remaining vertex is at max_depth too
+            break;
+        }
+        for (long e = edge_offsets[u]; e < edge_offsets[u + 1]; e++) {
+            int v = edge_targets[e];
+            if (seen[v] == epoch) {
+                continue;
+            }
+            if (order.size() >= cap) {
+                return order.size();
+            }
+            seen[v] = epoch;
+            depth[v] = static_cast<unsigned char>(d + 1);
+            order.push_back(v);
+            order_levels.push_back(static_cast<unsigned char>(d + 1));
+            if (is_target(v)) {
+                target_found = v;
+                return order.size();
+            }
+        }
+    }
+    return order.size();
+}
+
+int BoundedBFS::search(int start, int max_depth, int max_visited) {
+    next_epoch();
+    return run(start, [](int) { return false; }, max_depth, max_visited);
+}
+
+int BoundedBFS::search_targets(int start, const std::vector<int>& targets, int max_depth, int max_visited) {
+    next_epoch();
+    for (int t : targets) {
+        if (t >= 0 && t < num_vertices()) {
+            wanted[t] = epoch;
+        }
+    }
+    unsigned int current = epoch;
+    const std::vector<unsigned int>& marks = wanted;
+    return run(start, [&marks, current](int v) { return marks[v] == current; }, max_depth, max_visited);
+}
+
+int BoundedBFS::search_until(int start, const std::function<bool(int)>& is_target, int max_depth,
+                             int max_visited) {
+    next_epoch();
+    return run(start, is_target, max_depth, max_visited);
+}
+
+std::vector<int> BoundedBFS::visited() const {
+    return order;
+}
+
+std::vector<unsigned char> BoundedBFS::levels() const {
+    return order_levels;
+}
+
+int BoundedBFS::level(int v) const {
+    if (epoch == 0 || v < 0 || v >= num_vertices() || seen[v] != epoch) {
+        return -1;
+    }
+    return depth[v];
+}
+
+int BoundedBFS::found() const {
+    return target_found;
+}
@@ -2,6 +2,8 @@
 #ifndef BFS_SWIG_H
 #define BFS_SWIG_H
 
+#include <cstddef>
+#include <functional>
 #include <vector>
 #include <map>
 #include <utility>
@@ -15,7 +17,181 @@ typedef std::pair<int, std::map<int, int>> BFSResult;
 // BFS implementation
 BFSResult breadth_first_search(const Graph& graph, int start_node);
 
+// Shortest path from s to t (both included), or empty if t is unreachable.
+// Bidirectional BFS: grows one frontier from each end, always expanding the
+// smaller one by a full level, and stops at the first vertex both searches
+// reached, so it visits a small part of a large graph when s and t are
+// close. The backward search follows the same adjacency lists, so the graph
+// must be undirected (GraphHandle::shortest_path also handles directed ones).
+std::vector<int> shortest_path(const Graph& graph, int s, int t);
+
+// Connected component label of every vertex, in the graph's key order
+// (label[v] for create_sparse_graph graphs). A label is the smallest vertex
+// of its component. Afforest: lock-free union-find that first links two
+// sampled neighbors per vertex, then skips the vertices of the largest
+// component when linking the remaining edges, on threads threads (0 = one
+// per CPU). Edges to vertices that are not keys of graph are ignored;
+// directed graphs get weakly connected components and no skipping.
+std::vector<int> connected_components(const Graph& graph, int threads = 0, bool directed = false);
+
 // Graph creation helper
 Graph create_sparse_graph(int V, int E, bool directed = false);
 
+// Batched single-source BFS: one search per entry of start_nodes in one
+// call; returns the visited count of each
+std::vector<int> breadth_first_search_batch(const Graph& graph, const std::vector<int>& start_nodes);
+
+// Graph kept in C++ across calls. Python holds an opaque handle, so a search
+// converts neither the adjacency lists nor the parent map; results cross
+// the language boundary only through parents() and to_graph().
+class GraphHandle {
+public:
+    // Random sparse graph, as create_sparse_graph()
+    GraphHandle(int V, int E, bool directed = false);
+    // directed keeps reversed adjacency lists for shortest_path()
+    explicit GraphHandle(const Graph& graph, bool directed = false);
+
+    int num_vertices() const;
+
+    // breadth_first_search() from start_node; keeps the parent map in the
+    // handle and returns the visited count
+    int breadth_first_search(int start_node);
+
+    // breadth_first_search_batch() on this graph; keeps no parent map
+    std::vector<int> breadth_first_search_batch(const std::vector<int>& start_nodes) const;
+
+    // shortest_path() on this graph, following edge directions if the
+    // handle was built as directed
+    std::vector<int> shortest_path(int s, int t) const;
+
+    // connected_components() on this graph
+    std::vector<int> connected_components(int threads = 0) const;
+
+    // Parent map of the last search
+    std::map<int, int> parents() const;
+
+    Graph to_graph() const;
+
+#ifndef SWIG
+    const Graph& graph() const;
+#endif
+
+private:
+    Graph adjacency;
+    Graph reversed;                     // in-edges; empty for undirected graphs
+    bool directed;
+    std::map<int, int> last_parents;
+};
+
+// Adjacency lists compressed for graphs whose neighbor ids do not fit in
+// memory as CSR. Each list is sorted, delta-encoded and packed as Stream
+// VByte: a 2-bit byte count per gap in a control stream and 1-4 data bytes
+// per gap, so local or dense neighborhoods take 1-2 bytes per edge instead
+// of 4. Vertices are the graph's keys in order, numbered 0..n-1 (the vertex
+// ids of create_sparse_graph graphs).
+class CompressedGraph {
+public:
+    explicit CompressedGraph(const Graph& graph);
+#ifndef SWIG
+    // From compressed rows: the neighbors of v are
+    // targets[offsets[v] .. offsets[v + 1]), offsets has n + 1 entries
+    CompressedGraph(const std::vector<long>& offsets, const std::vector<int>& targets);
+
+    // Incremental build, for graphs whose CSR does not fit in memory next to
+    // the encoding: append the neighbors of vertices 0, 1, ... one list at a
+    // time, then finish(). Only the encoded stream is kept, so the input can
+    // be streamed from disk or generated. A list may be in any order and ids
+    // outside 0..num_vertices-1 are dropped. Vertices without an appended
+    // list get none. Queries find no neighbors until finish().
+    explicit CompressedGraph(int num_vertices);
+    // False once every vertex has its list
+    bool append_list(const int* neighbors, int count);
+    void finish();
+#endif
+
+    int num_vertices() const;
+    long num_edges() const;
+
+    // Encoded lists plus their byte offsets
+    long long bytes() const;
+    // The same graph as uncompressed CSR (8-byte offsets, 4-byte ids)
+    long long csr_bytes() const;
+
+    // Neighbors of v in ascending order
+    std::vector<int> neighbors(int v) const;
+
+    // BFS from start over the encoded lists, decoding each list as it is
+    // reached (four gaps at a time with SSSE3 where the CPU has it); returns
+    // the visited count like breadth_first_search()
+    int breadth_first_search(int start) const;
+
+private:
+    int decode(int v, int* out) const;
+
+    int vertices;
+    long edges;
+    int max_degree;
+    int appended;                           // lists appended so far
+    bool finished;
+    std::vector<int> scratch;               // the list being encoded
+    std::vector<size_t> list_offsets;       // byte offset of each list in stream
+    std::vector<unsigned char> stream;      // per list: varint degree, control bytes, data
+};
+
+// BFS for k-hop neighborhoods and goal-directed queries: a search stops at
+// max_depth hops, after max_visited vertices, or at the first target it
+// reaches, and only the vertices it visited are returned. Visited state is
+// kept across queries and tagged with a per-query epoch, so a search costs
+// only what it touches instead of clearing O(V) arrays. Vertices are the
+// graph's keys in order, numbered 0..n-1, as in CompressedGraph.
+class BoundedBFS {
+public:
+    explicit BoundedBFS(const Graph& graph);
+
+    int num_vertices() const;
+
+    // Searches from start up to max_depth hops (at most 255, the range of
+    // levels()); max_visited = 0 means no cap. Returns the visited count.
+    int search(int start, int max_depth = 255, int max_visited = 0);
+
+    // As search(), stopping as soon as any vertex of targets is visited
+    int search_targets(int start, const std::vector<int>& targets, int max_depth = 255, int max_visited = 0);
+
+#ifndef SWIG
+    // As search(), stopping at the first visited vertex with is_target(v)
+    int search_until(int start, const std::function<bool(int)>& is_target, int max_depth = 255,
+                     int max_visited = 0);
+#endif
+
+    // Vertices visited by the last search in BFS order, and the hop count
+    // of each
+    std::vector<int> visited() const;
+    std::vector<unsigned char> levels() const;
+
+    // Hop count of v in the last search, or -1 if it was not visited
+    int level(int v) const;
+
+    // The target the last search stopped at, or -1
+    int found() const;
+
+private:
+    BoundedBFS(const BoundedBFS&);
+    BoundedBFS& operator=(const BoundedBFS&);
+
+    // Starts a query: a fresh epoch, so every stamp from earlier ones is stale
+    void next_epoch();
+    template <class IsTarget>
+    int run(int start, const IsTarget& is_target, int max_depth, int max_visited);
+
+    std::vector<long> edge_offsets;             // compressed rows of the graph
+    std::vector<int> edge_targets;
+    std::vector<unsigned int> seen;             // epoch of the query that visited v
+    std::vector<unsigned int> wanted;           // epoch of the query that targets v
+    std::vector<unsigned char> depth;           // hop count of v, valid where seen[v] == epoch
+    unsigned int epoch;
+    std::vector<int> order;                     // visited vertices; doubles as the queue
+    std::vector<unsigned char> order_levels;
+    int target_found;
+};
+
 #endif // BFS_SWIG_H
\ No newline at end of file
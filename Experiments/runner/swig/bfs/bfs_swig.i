@@ -11,6 +11,7 @@
 
 namespace std {
     %template(IntVector) vector<int>;
+    %template(LevelVector) vector<unsigned char>;
     %template(IntMap) map<int, int>;
     %template(Graph) map<int, vector<int>>;
     %template(BFSResult) pair<int, map<int, int>>;
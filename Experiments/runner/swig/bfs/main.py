@@ -1,8 +1,44 @@
 import time
 import random
+import os
+import sys
 import bfs_swig
 
-def benchmark_bfs(V, E, num_runs=5):
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency, use_handles
+
+metrics = KernelMetrics()
+
+def prepare_bfs(V, E, num_runs=5):
+    """Generates the graphs and start nodes for num_runs runs and warms up the kernel."""
+    label = f"V={V} E={E}"
+    handles = use_handles()
+    
+    # Generate the initial graphs and start nodes for each run
+    with metrics.span(f"generate {label}"):
+        datasets = []
+        for _ in range(num_runs):
+            if handles:
+                graph = bfs_swig.GraphHandle(V, E, False)
+            else:
+                graph = bfs_swig.create_sparse_graph(V, E, False)
+            # Choose a random start node
+            start_node = random.randrange(V) if V > 0 else 0
+            datasets.append((graph, start_node))
+    
+    # Warm-up run
+    V_warmup = max(10, V // 10)
+    E_warmup = max(5, E // 10)
+    graph_warmup = bfs_swig.create_sparse_graph(V_warmup, E_warmup)
+    
+    if graph_warmup:
+        bfs_swig.breadth_first_search(graph_warmup, 0)
+    
+    return datasets
+
+
+def benchmark_bfs(V, E, num_runs=5, inputs=None):
     """
     Benchmarks the BFS algorithm on a sparse graph (SWIG version).
     
@@ -10,48 +46,54 @@ def benchmark_bfs(V, E, num_runs=5):
         V (int): Number of vertices.
         E (int): Number of edges.
         num_runs (int): The number of times to run the iteration for averaging.
+        inputs: Result of prepare_bfs(V, E, num_runs), generated here if None.
         
     Returns:
         dict: Results including average time.
     """
     total_time = 0
+    label = f"V={V} E={E}"
+    handles = use_handles()
+    datasets = inputs if inputs is not None else prepare_bfs(V, E, num_runs)
     
-    # Generate the initial graphs and start nodes for each run
-    datasets = []
-    for _ in range(num_runs):
-        graph = bfs_swig.create_sparse_graph(V, E, False)
-        # Choose a random start node
-        start_node = random.randrange(V) if V > 0 else 0
-        datasets.append((graph, start_node))
-    
-    # Warm-up run
-    V_warmup = max(10, V // 10)
-    E_warmup = max(5, E // 10)
-    graph_warmup = bfs_swig.create_sparse_graph(V_warmup, E_warmup)
-    
-    if graph_warmup:
-        bfs_swig.breadth_first_search(graph_warmup, 0)
-    
-    for graph, start_node in datasets:
-        start_time = time.perf_counter()
-        # Execute BFS
-        bfs_swig.breadth_first_search(graph, start_node)
-        end_time = time.perf_counter()
+    runs = 0
+    for run in metrics.repetitions(label, num_runs):
+        graph, start_node = datasets[run % len(datasets)]
+        with metrics.measure(label):
+            start_time = time.perf_counter()
+            # Execute BFS
+            if handles:
+                graph.breadth_first_search(start_node)
+            else:
+                bfs_swig.breadth_first_search(graph, start_node)
+            end_time = time.perf_counter()
         
         total_time += (end_time - start_time)
+        runs += 1
 
-    avg_time_ms = (total_time / num_runs) * 1000
+    avg_time_ms = (total_time / runs) * 1000
     
     return {
         "algorithm": "Breadth-First Search (BFS) - SWIG",
         "V": V,
         "E": E,
         "complexity": "O(V + E)",
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_time_ms": avg_time_ms,
+        "latency": metrics.latency(label),
     }
 
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_bfs, benchmark_bfs, (10000, 25000, 5)),
+    (prepare_bfs, benchmark_bfs, (50000, 75000, 5)),
+]
+
+
 # --- Execution ---
 
 if __name__ == "__main__":
@@ -61,8 +103,7 @@ if __name__ == "__main__":
     print("-" * 60)
     
     # --- BFS Benchmark Test 1: Moderate V and E ---
-    V1, E1 = 10000, 25000  # 10k nodes, 25k edges
-    runs1 = 5
+    V1, E1, runs1 = WORKLOADS[0][2]  # 10k nodes, 25k edges
     
     print(f"\n--- Test 1: V={V1:,}, E={E1:,} (Moderate Sparse Graph) ---")
     results1 = benchmark_bfs(V1, E1, runs1)
@@ -73,12 +114,12 @@ if __name__ == "__main__":
     print(f"Complexity: {results1['complexity']}")
     print(f"Total Runs: {results1['num_runs']}")
     print(f"Average Execution Time: {results1['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results1['latency'])}")
     
     print("-" * 60)
     
     # --- BFS Benchmark Test 2: High V (many nodes), Low E (very sparse) ---
-    V2, E2 = 50000, 75000  # 50k nodes, 75k edges
-    runs2 = 5
+    V2, E2, runs2 = WORKLOADS[1][2]  # 50k nodes, 75k edges
     
     print(f"\n--- Test 2: V={V2:,}, E={E2:,} (Larger, Sparser Graph) ---")
     results2 = benchmark_bfs(V2, E2, runs2)
@@ -89,5 +130,8 @@ if __name__ == "__main__":
     print(f"Complexity: {results2['complexity']}")
     print(f"Total Runs: {results2['num_runs']}")
     print(f"Average Execution Time: {results2['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results2['latency'])}")
+    
+    print("-" * 60)
     
-    print("-" * 60)
\ No newline at end of file
+    metrics.save()
@@ -5,7 +5,10 @@ bfs_module = Extension(
     '_bfs_swig',
     sources=['bfs_swig.i', 'bfs_swig.cpp'],
     swig_opts=['-c++'],
-    extra_compile_args=['-O3', '-std=c++11'],
+    include_dirs=['../instrument', '../batch'],  # kernel_trace.h, batch_dispatch.h
+    libraries=['dl'],
+    extra_compile_args=['-O3', '-std=c++11', '-pthread'],
+    extra_link_args=['-pthread'],
 )
 
 setup(
@@ -0,0 +1,30 @@
+#!/bin/sh
+# build_modules.sh
+# Generates the SWIG wrappers and builds the extension modules in place.
+# The *_swig_wrap.cpp files, the *_swig.py proxies and the build/ trees are
+# outputs of this step and are not committed: rerun it after changing a .h
+# or .i file, or after switching Python versions.
+#
+#   ./build_modules.sh [module ...]     (default: all of them)
+#
+# Needs swig (4.0 or later), make, a C++11 compiler and the Python headers.
+set -e
+cd "$(dirname "$0")"
+PYTHON=${PYTHON:-python3}
+
+if ! command -v swig >/dev/null 2>&1; then
+    echo "build_modules.sh: swig not found in PATH" >&2
+    exit 1
+fi
+
+if [ $# -eq 0 ]; then
+    set -- instrument trace marshal bfs convex dense_matrix fft json_bench k_means nbody quick_sort regex sieve
+fi
+
+# The kernel thread pool that the modules with *_async() kernels link
+make -C ../native build/libkernel_async.so
+
+for module in "$@"; do
+    echo "== $module"
+    (cd "$module" && "$PYTHON" setup.py build_ext --inplace)
+done
@@ -1,7 +1,9 @@
 // conv_swig.cpp
 #include "conv_swig.h"
+#include "kernel_trace.h"
 
 Vector1D convolution_1d(const Vector1D& data, const Vector1D& kernel) {
+    KERNEL_TRACE_SPAN("convolution_1d");
     int data_len = data.size();
     int kernel_len = kernel.size();
     
@@ -38,6 +40,7 @@ Vector1D convolution_1d(const Vector1D& data, const Vector1D& kernel) {
 }
 
 Matrix2D convolution_2d(const Matrix2D& image, const Matrix2D& kernel) {
+    KERNEL_TRACE_SPAN("convolution_2d");
     int rows = image.size();
     
     if (rows == 0) {
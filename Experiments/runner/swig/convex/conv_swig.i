@@ -12,4 +12,8 @@ namespace std {
     %template(Matrix2D) vector<vector<double>>;
 }
 
+%include "move_result.i"
+%move_result(std::vector<double>, convolution_1d);
+%move_result(std::vector<std::vector<double> >, convolution_2d);
+
 %include "conv_swig.h"
\ No newline at end of file
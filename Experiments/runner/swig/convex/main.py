@@ -1,7 +1,15 @@
 import time
 import random
+import os
+import sys
 import conv_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency
+
+metrics = KernelMetrics()
+
 # --- Convolution Implementations (Python version for reference) ---
 
 def convolution_1d(data, kernel):
@@ -57,37 +65,56 @@ def convolution_2d(image, kernel):
 
 # --- Convolution Benchmarking Function (SWIG version) ---
 
-def benchmark_convolution(data_size, kernel_size, num_runs=5):
-    """Benchmarks 1D and 2D convolution (SWIG version) for given data sizes and kernel sizes."""
-    
+def prepare_convolution(data_size, kernel_size, num_runs=5):
+    """Generates the 1D and 2D inputs for benchmark_convolution()."""
     # 1. Setup 1D Data and Kernel
-    data_1d = [random.random() for _ in range(data_size)]
-    kernel_1d = [random.random() for _ in range(kernel_size)]
+    with metrics.span(f"generate n={data_size} k={kernel_size}"):
+        data_1d = [random.random() for _ in range(data_size)]
+        kernel_1d = [random.random() for _ in range(kernel_size)]
     
-    # 2. Setup 2D Data (Square image) and Kernel
+        # 2. Setup 2D Data (Square image) and Kernel
+        image_dim = data_size
+        data_2d = [[random.random() for _ in range(image_dim)] for _ in range(image_dim)]
+        kernel_2d = [[random.random() for _ in range(kernel_size)] for _ in range(kernel_size)]
+    
+    return data_1d, kernel_1d, data_2d, kernel_2d
+
+
+def benchmark_convolution(data_size, kernel_size, num_runs=5, inputs=None):
+    """Benchmarks 1D and 2D convolution (SWIG version) for given data sizes and kernel sizes.
+
+    inputs is the result of prepare_convolution(), generated here if None.
+    """
+    if inputs is None:
+        inputs = prepare_convolution(data_size, kernel_size, num_runs)
+    data_1d, kernel_1d, data_2d, kernel_2d = inputs
     image_dim = data_size
-    data_2d = [[random.random() for _ in range(image_dim)] for _ in range(image_dim)]
-    kernel_2d = [[random.random() for _ in range(kernel_size)] for _ in range(kernel_size)]
     
     results = {}
+    label_1d = f"conv1d n={data_size} k={kernel_size}"
+    label_2d = f"conv2d n={image_dim} k={kernel_size}"
     
     # --- Benchmark 1D ---
     total_time_1d = 0
     # Warmup
     conv_swig.convolution_1d(data_1d[:int(data_size * 0.1)], kernel_1d) 
     
-    for _ in range(num_runs):
-        start_time = time.perf_counter()
-        conv_swig.convolution_1d(data_1d, kernel_1d)
-        end_time = time.perf_counter()
+    runs_1d = 0
+    for _ in metrics.repetitions(label_1d, num_runs):
+        with metrics.measure(label_1d):
+            start_time = time.perf_counter()
+            conv_swig.convolution_1d(data_1d, kernel_1d)
+            end_time = time.perf_counter()
         total_time_1d += (end_time - start_time)
+        runs_1d += 1
         
     results['1D'] = {
         'algorithm': "Convolution 1D (SWIG)",
         'data_size': f"{data_size:,} elements",
         'kernel_size': f"{kernel_size}x1",
         'complexity': "O(N * K)",
-        'avg_time_ms': (total_time_1d / num_runs) * 1000,
+        'avg_time_ms': (total_time_1d / runs_1d) * 1000,
+        'latency': metrics.latency(label_1d),
     }
 
     # --- Benchmark 2D ---
@@ -100,23 +127,37 @@ def benchmark_convolution(data_size, kernel_size, num_runs=5):
             kernel_2d
         ) 
     
-    for _ in range(num_runs):
-        start_time = time.perf_counter()
-        conv_swig.convolution_2d(data_2d, kernel_2d)
-        end_time = time.perf_counter()
+    runs_2d = 0
+    for _ in metrics.repetitions(label_2d, num_runs):
+        with metrics.measure(label_2d):
+            start_time = time.perf_counter()
+            conv_swig.convolution_2d(data_2d, kernel_2d)
+            end_time = time.perf_counter()
         total_time_2d += (end_time - start_time)
+        runs_2d += 1
 
     results['2D'] = {
         'algorithm': "Convolution 2D (SWIG)",
         'data_size': f"{image_dim:,}x{image_dim:,} pixels",
         'kernel_size': f"{kernel_size}x{kernel_size}",
         'complexity': "O(N^2 * K^2)",
-        'avg_time_ms': (total_time_2d / num_runs) * 1000,
+        'avg_time_ms': (total_time_2d / runs_2d) * 1000,
+        'latency': metrics.latency(label_2d),
     }
     
     return results
 
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_convolution, benchmark_convolution, (600, 7, 10)),
+    (prepare_convolution, benchmark_convolution, (250, 5, 5)),
+]
+
+
 # --- Execution ---
 
 if __name__ == "__main__":
@@ -128,9 +169,7 @@ if __name__ == "__main__":
     # --- 1D and 2D Convolution Benchmark ---
     
     # Test 1: 1D Signal
-    data_size_1d = 600
-    kernel_size_1d = 7
-    runs_1d = 10
+    data_size_1d, kernel_size_1d, runs_1d = WORKLOADS[0][2]
     
     print(f"\n--- Benchmarking Convolution (1D Signal) ---")
     results_conv = benchmark_convolution(data_size_1d, kernel_size_1d, runs_1d)
@@ -142,13 +181,12 @@ if __name__ == "__main__":
     print(f"Complexity: {results_1d['complexity']}")
     print(f"Total Runs: {runs_1d}")
     print(f"Average Execution Time: {results_1d['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_1d['latency'])}")
     
     print("-" * 60)
     
     # Test 2: 2D Image
-    image_dim = 250
-    kernel_size_2d = 5
-    runs_2d = 5
+    image_dim, kernel_size_2d, runs_2d = WORKLOADS[1][2]
     
     print(f"\n--- Benchmarking Convolution (2D Image) ---")
     results_conv = benchmark_convolution(image_dim, kernel_size_2d, runs_2d)
@@ -159,4 +197,7 @@ if __name__ == "__main__":
     print(f"Kernel Size: {results_2d['kernel_size']}")
     print(f"Complexity: {results_2d['complexity']}")
     print(f"Total Runs: {runs_2d}")
-    print(f"Average Execution Time: {results_2d['avg_time_ms']:.4f} ms")
\ No newline at end of file
+    print(f"Average Execution Time: {results_2d['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_2d['latency'])}")
+    
+    metrics.save()
@@ -12,13 +12,22 @@ Methods:
     - swig_naive : SWIG naive implementation
     - swig_blocked : SWIG blocked implementation
     - swig_transpose : SWIG with transposed B
+    - swig_parallel : SWIG transposed B, rows split over --threads threads
 """
 import numpy as np
 import time
 import argparse
 import csv
+import os
+import sys
 import matmul_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency, use_handles
+
+metrics = KernelMetrics()
+
 # ------------------ Implementations ------------------
 
 def matmul_naive(A, B):
@@ -56,15 +65,26 @@ def matmul_numpy(A, B):
 
 # ------------------ Benchmark Logic ------------------
 
-def benchmark(method, N, runs=3, block_size=64, seed=0):
+def prepare(method, N, runs=3, block_size=64, seed=0, threads=0):
+    """Generate the matrices for benchmark() and warm up the method."""
     np.random.seed(seed)
-    A = np.random.rand(N, N)
-    B = np.random.rand(N, N)
+    A_list = B_list = None
+    A_h = B_h = C_h = None
+    with metrics.span(f"generate N={N}"):
+        A = np.random.rand(N, N)
+        B = np.random.rand(N, N)
     
-    # Convert to list of lists for SWIG methods
-    if method.startswith("swig_"):
-        A_list = A.tolist()
-        B_list = B.tolist()
+        # Convert to list of lists for SWIG methods
+        if method.startswith("swig_"):
+            A_list = A.tolist()
+            B_list = B.tolist()
+
+        # Or keep them in C++, along with the product
+        handles = method.startswith("swig_") and use_handles()
+        if handles:
+            A_h = matmul_swig.MatrixHandle(A_list)
+            B_h = matmul_swig.MatrixHandle(B_list)
+            C_h = matmul_swig.MatrixHandle()
     
     # Warmup
     if method == "naive":
@@ -76,26 +96,51 @@ def benchmark(method, N, runs=3, block_size=64, seed=0):
     else:
         _ = matmul_numpy(A[:8, :8], B[:8, :8])
     
+    return A, B, A_list, B_list, handles, A_h, B_h, C_h
+
+
+def benchmark(method, N, runs=3, block_size=64, seed=0, threads=0, inputs=None):
+    """Time runs multiplications; inputs is the result of prepare(), generated here if None."""
+    if inputs is None:
+        inputs = prepare(method, N, runs, block_size, seed, threads)
+    A, B, A_list, B_list, handles, A_h, B_h, C_h = inputs
+    
     results = []
-    for r in range(runs):
-        start = time.perf_counter()
+    label = f"{method} N={N}"
+    for r in metrics.repetitions(label, runs):
+        with metrics.measure(label):
+            start = time.perf_counter()
         
-        if method == "naive":
-            C = matmul_naive(A, B)
-        elif method == "blocked":
-            C = matmul_blocked(A, B, block_size)
-        elif method == "numpy":
-            C = matmul_numpy(A, B)
-        elif method == "swig_naive":
-            C = matmul_swig.matmul_naive(A_list, B_list)
-        elif method == "swig_blocked":
-            C = matmul_swig.matmul_blocked(A_list, B_list, block_size)
-        elif method == "swig_transpose":
-            C = matmul_swig.matmul_transpose(A_list, B_list)
-        else:
-            raise ValueError(f"Unknown method: {method}")
+            if method == "naive":
+                C = matmul_naive(A, B)
+            elif method == "blocked":
+                C = matmul_blocked(A, B, block_size)
+            elif method == "numpy":
+                C = matmul_numpy(A, B)
+            elif method == "swig_naive":
+                if handles:
+                    matmul_swig.matmul_naive_into(A_h, B_h, C_h)
+                else:
+                    C = matmul_swig.matmul_naive(A_list, B_list)
+            elif method == "swig_blocked":
+                if handles:
+                    matmul_swig.matmul_blocked_into(A_h, B_h, C_h, block_size)
+                else:
+                    C = matmul_swig.matmul_blocked(A_list, B_list, block_size)
+            elif method == "swig_transpose":
+                if handles:
+                    matmul_swig.matmul_transpose_into(A_h, B_h, C_h)
+                else:
+                    C = matmul_swig.matmul_transpose(A_list, B_list)
+            elif method == "swig_parallel":
+                if handles:
+                    matmul_swig.matmul_parallel_into(A_h, B_h, C_h, threads)
+                else:
+                    C = matmul_swig.matmul_parallel(A_list, B_list, threads)
+            else:
+                raise ValueError(f"Unknown method: {method}")
         
-        end = time.perf_counter()
+            end = time.perf_counter()
         elapsed = end - start
         flops = 2 * (N ** 3)
         gflops = flops / (elapsed * 1e9)
@@ -110,24 +155,37 @@ def benchmark(method, N, runs=3, block_size=64, seed=0):
         
         print(f"[Run {r+1}/{runs}] {method:15s} | N={N:4d} | Time={elapsed:.4f}s | {gflops:.2f} GFLOPS")
     
+    print(f"{method:15s} | N={N:4d} | Latency: {format_latency(metrics.latency(label))}")
     return results
 
 
+# ------------------ Workloads ------------------
+
+# (prepare, benchmark, arguments) of the default command line; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare, benchmark, ("swig_naive", 512, 3)),
+]
+
+
 # ------------------ CLI ------------------
 
 def main():
     parser = argparse.ArgumentParser(description="Dense matrix multiplication benchmark (SWIG).")
-    parser.add_argument("--size", "-n", type=int, default=512, help="Matrix size N (NxN)")
-    parser.add_argument("--runs", "-r", type=int, default=3, help="Number of runs")
+    default_method, default_size, default_runs = WORKLOADS[0][2]
+    parser.add_argument("--size", "-n", type=int, default=default_size, help="Matrix size N (NxN)")
+    parser.add_argument("--runs", "-r", type=int, default=default_runs, help="Number of runs")
     parser.add_argument("--method", "-m", 
-                       choices=["naive", "blocked", "numpy", "swig_naive", "swig_blocked", "swig_transpose"], 
-                       default="swig_naive")
+                       choices=["naive", "blocked", "numpy", "swig_naive", "swig_blocked", "swig_transpose",
+                                "swig_parallel"], 
+                       default=default_method)
     parser.add_argument("--block", "-b", type=int, default=64, help="Block size for blocked method")
+    parser.add_argument("--threads", "-t", type=int, default=0, help="Threads for swig_parallel (0 = one per CPU)")
     parser.add_argument("--output", "-o", type=str, default="", help="Optional CSV output file")
     
     args = parser.parse_args()
     
-    results = benchmark(args.method, args.size, args.runs, args.block)
+    results = benchmark(args.method, args.size, args.runs, args.block, threads=args.threads)
     
     if args.output:
         with open(args.output, "w", newline="") as f:
@@ -138,4 +196,5 @@ def main():
 
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
+    metrics.save()
\ No newline at end of file
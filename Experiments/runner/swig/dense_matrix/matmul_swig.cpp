@@ -1,8 +1,13 @@
 // matmul_swig.cpp
 #include "matmul_swig.h"
+#include "kernel_trace.h"
 #include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 Matrix2D matmul_naive(const Matrix2D& A, const Matrix2D& B) {
+    KERNEL_TRACE_SPAN("matmul_naive");
     if (A.empty() || B.empty()) {
         return Matrix2D();
     }
@@ -23,7 +28,11 @@ Matrix2D matmul_naive(const Matrix2D& A, const Matrix2D& B) {
     return C;
 }
 
-Matrix2D matmul_blocked(const Matrix2D& A, const Matrix2D& B, int block_size) {
+// progress is told after each block row, and the product stops early once
+// it reports a cancellation
+static Matrix2D blocked_product(const Matrix2D& A, const Matrix2D& B, int block_size,
+                                KernelProgress& progress) {
+    KERNEL_TRACE_SPAN("matmul_blocked");
     if (A.empty() || B.empty()) {
         return Matrix2D();
     }
@@ -50,12 +59,29 @@ Matrix2D matmul_blocked(const Matrix2D& A, const Matrix2D& B, int block_size) {
                 }
             }
         }
+        if (!progress.update(static_cast<double>(std::min(ii + block_size, n)) / n)) {
+            break;
+        }
     }
     
     return C;
 }
 
+Matrix2D matmul_blocked(const Matrix2D& A, const Matrix2D& B, int block_size) {
+    KernelProgress progress;
+    return blocked_product(A, B, block_size, progress);
+}
+
+KernelResultFuture<Matrix2D>* matmul_blocked_async(const Matrix2D& A, const Matrix2D& B, int block_size) {
+    std::shared_ptr<Matrix2D> a(new Matrix2D(A));
+    std::shared_ptr<Matrix2D> b(new Matrix2D(B));
+    return submit_kernel<Matrix2D>([a, b, block_size](KernelProgress& progress) {
+        return blocked_product(*a, *b, block_size, progress);
+    });
+}
+
 Matrix2D matmul_transpose(const Matrix2D& A, const Matrix2D& B) {
+    KERNEL_TRACE_SPAN("matmul_transpose");
     if (A.empty() || B.empty()) {
         return Matrix2D();
     }
@@ -83,4 +109,117 @@ Matrix2D matmul_transpose(const Matrix2D& A, const Matrix2D& B) {
     }
     
     return C;
-}
\ No newline at end of file
+}
+
+// Rows [row_begin, row_end) of C = A * B_T^T
+static void multiply_rows(const Matrix2D& A, const Matrix2D& B_T, Matrix2D& C,
+                          int row_begin, int row_end) {
+    KERNEL_TRACE_SPAN("matmul_rows");
+    int n = B_T.size();
+    int inner = A[0].size();
+    for (int i = row_begin; i < row_end; i++) {
+        for (int j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < inner; k++) {
+                sum += A[i][k] * B_T[j][k];
+            }
+            C[i][j] = sum;
+        }
+    }
+}
+
+Matrix2D matmul_parallel(const Matrix2D& A, const Matrix2D& B, int threads) {
+    KERNEL_TRACE_SPAN("matmul_parallel");
+    if (A.empty() || B.empty()) {
+        return Matrix2D();
+    }
+    
+    int n = A.size();
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, n);
+    
+    Matrix2D C(n, Vector1D(n, 0.0));
+    
+    // Transpose B for better cache locality
+    Matrix2D B_T(n, Vector1D(n, 0.0));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            B_T[j][i] = B[i][j];
+        }
+    }
+    
+    // Contiguous row blocks; the calling thread takes the first one
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (int t = 1; t < threads; t++) {
+        workers.push_back(std::thread(multiply_rows, std::cref(A), std::cref(B_T), std::ref(C),
+                                      static_cast<int>(static_cast<long>(n) * t / threads),
+                                      static_cast<int>(static_cast<long>(n) * (t + 1) / threads)));
+    }
+    multiply_rows(A, B_T, C, 0, n / threads);
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    
+    return C;
+}
+
+MatrixHandle::MatrixHandle(int rows, int cols) : data(rows, Vector1D(cols, 0.0)) {}
+
+MatrixHandle::MatrixHandle(const Matrix2D& values) : data(values) {}
+
+int MatrixHandle::rows() const {
+    return data.size();
+}
+
+int MatrixHandle::cols() const {
+    return data.empty() ? 0 : data[0].size();
+}
+
+void MatrixHandle::check_index(int i, int j) const {
+    // Rows of a handle built from a list may differ in length
+    if (i < 0 || i >= static_cast<int>(data.size()) || j < 0 || j >= static_cast<int>(data[i].size())) {
+        throw std::out_of_range("MatrixHandle index (" + std::to_string(i) + ", " + std::to_string(j) +
+                                ") out of range");
+    }
+}
+
+double MatrixHandle::get(int i, int j) const {
+    check_index(i, j);
+    return data[i][j];
+}
+
+void MatrixHandle::set(int i, int j, double value) {
+    check_index(i, j);
+    data[i][j] = value;
+}
+
+Matrix2D MatrixHandle::to_list() const {
+    return data;
+}
+
+const Matrix2D& MatrixHandle::values() const {
+    return data;
+}
+
+Matrix2D& MatrixHandle::values() {
+    return data;
+}
+
+void matmul_naive_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C) {
+    C.values() = matmul_naive(A.values(), B.values());
+}
+
+void matmul_blocked_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C, int block_size) {
+    C.values() = matmul_blocked(A.values(), B.values(), block_size);
+}
+
+void matmul_transpose_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C) {
+    C.values() = matmul_transpose(A.values(), B.values());
+}
+
+void matmul_parallel_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C, int threads) {
+    C.values() = matmul_parallel(A.values(), B.values(), threads);
+}
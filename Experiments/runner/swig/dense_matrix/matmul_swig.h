@@ -2,6 +2,8 @@
 #ifndef MATMUL_SWIG_H
 #define MATMUL_SWIG_H
 
+#include "kernel_async.h"
+
 #include <vector>
 
 // Type definitions
@@ -14,7 +16,49 @@ Matrix2D matmul_naive(const Matrix2D& A, const Matrix2D& B);
 // Blocked/tiled matrix multiplication for better cache reuse
 Matrix2D matmul_blocked(const Matrix2D& A, const Matrix2D& B, int block_size = 64);
 
+// matmul_blocked() on the kernel thread pool. A and B are copied, so the
+// caller may drop them; progress advances per block row and cancel() stops
+// the product at the next one.
+KernelResultFuture<Matrix2D>* matmul_blocked_async(const Matrix2D& A, const Matrix2D& B, int block_size = 64);
+
 // Optimized matrix multiplication with transposed B
 Matrix2D matmul_transpose(const Matrix2D& A, const Matrix2D& B);
 
+// matmul_transpose with the rows of C split over threads (0 = one per CPU)
+Matrix2D matmul_parallel(const Matrix2D& A, const Matrix2D& B, int threads = 0);
+
+// Matrix kept in C++ across calls, so repeated products convert neither the
+// operands from Python lists nor the product back; to_list() exports it
+class MatrixHandle {
+public:
+    // rows x cols zeros
+    MatrixHandle(int rows = 0, int cols = 0);
+    explicit MatrixHandle(const Matrix2D& values);
+
+    int rows() const;
+    int cols() const;
+
+    // Throw std::out_of_range outside the matrix (IndexError in Python)
+    double get(int i, int j) const;
+    void set(int i, int j, double value);
+
+    Matrix2D to_list() const;
+
+#ifndef SWIG
+    const Matrix2D& values() const;
+    Matrix2D& values();
+#endif
+
+private:
+    void check_index(int i, int j) const;
+
+    Matrix2D data;
+};
+
+// The products above on handles; the product replaces C's contents
+void matmul_naive_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C);
+void matmul_blocked_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C, int block_size = 64);
+void matmul_transpose_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C);
+void matmul_parallel_into(const MatrixHandle& A, const MatrixHandle& B, MatrixHandle& C, int threads = 0);
+
 #endif // MATMUL_SWIG_H
\ No newline at end of file
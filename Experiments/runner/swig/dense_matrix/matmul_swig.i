@@ -12,4 +12,42 @@ namespace std {
     %template(Matrix2D) vector<vector<double>>;
 }
 
+%include "std_string.i"
+%include "exception.i"
+
+// Element access outside the matrix raises IndexError
+%exception MatrixHandle::get {
+    try {
+        $action
+    } catch (const std::out_of_range& e) {
+        SWIG_exception(SWIG_IndexError, e.what());
+    }
+}
+%exception MatrixHandle::set {
+    try {
+        $action
+    } catch (const std::out_of_range& e) {
+        SWIG_exception(SWIG_IndexError, e.what());
+    }
+}
+
+// result() before a successful finish raises RuntimeError
+%exception KernelResultFuture<std::vector<std::vector<double> > >::result {
+    try {
+        $action
+    } catch (const std::runtime_error& e) {
+        SWIG_exception(SWIG_RuntimeError, e.what());
+    }
+}
+
+%include "kernel_async.h"
+%template(MatrixFuture) KernelResultFuture<std::vector<std::vector<double> > >;
+%newobject matmul_blocked_async;
+
+%include "move_result.i"
+%move_result(std::vector<std::vector<double> >, matmul_naive);
+%move_result(std::vector<std::vector<double> >, matmul_blocked);
+%move_result(std::vector<std::vector<double> >, matmul_transpose);
+%move_result(std::vector<std::vector<double> >, matmul_parallel);
+
 %include "matmul_swig.h"
\ No newline at end of file
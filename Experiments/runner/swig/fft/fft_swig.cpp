@@ -1,5 +1,6 @@
 // fft_swig.cpp
 #include "fft_swig.h"
+#include "kernel_trace.h"
 #include <cmath>
 
 #ifndef M_PI
@@ -7,6 +8,7 @@
 #endif
 
 ComplexVector dft_naive(const ComplexVector& x) {
+    KERNEL_TRACE_SPAN("dft_naive");
     int N = x.size();
     ComplexVector X(N);
     
@@ -23,7 +25,8 @@ ComplexVector dft_naive(const ComplexVector& x) {
     return X;
 }
 
-ComplexVector fft_cooley_tukey(const ComplexVector& x) {
+// Recursive step of fft_cooley_tukey (no trace span per level)
+static ComplexVector cooley_tukey(const ComplexVector& x) {
     int N = x.size();
     
     // Base case
@@ -48,8 +51,8 @@ ComplexVector fft_cooley_tukey(const ComplexVector& x) {
     }
     
     // Conquer
-    ComplexVector even_fft = fft_cooley_tukey(even);
-    ComplexVector odd_fft = fft_cooley_tukey(odd);
+    ComplexVector even_fft = cooley_tukey(even);
+    ComplexVector odd_fft = cooley_tukey(odd);
     
     // Combine
     ComplexVector X(N);
@@ -65,7 +68,13 @@ ComplexVector fft_cooley_tukey(const ComplexVector& x) {
     return X;
 }
 
+ComplexVector fft_cooley_tukey(const ComplexVector& x) {
+    KERNEL_TRACE_SPAN("fft_cooley_tukey");
+    return cooley_tukey(x);
+}
+
 ComplexVector fft_iterative(const ComplexVector& x) {
+    KERNEL_TRACE_SPAN("fft_iterative");
     int N = x.size();
     
     // Check if N is power of 2
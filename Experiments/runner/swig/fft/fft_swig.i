@@ -13,4 +13,9 @@ namespace std {
     %template(ComplexVector) vector<complex<double>>;
 }
 
+%include "move_result.i"
+%move_result(std::vector<std::complex<double> >, dft_naive);
+%move_result(std::vector<std::complex<double> >, fft_cooley_tukey);
+%move_result(std::vector<std::complex<double> >, fft_iterative);
+
 %include "fft_swig.h"
\ No newline at end of file
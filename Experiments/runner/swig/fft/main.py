@@ -16,8 +16,16 @@ import numpy as np
 import time
 import argparse
 import csv
+import os
+import sys
 import fft_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency
+
+metrics = KernelMetrics()
+
 # ------------------ Implementations ------------------
 
 def dft_naive(x):
@@ -44,15 +52,18 @@ def fft_numpy(x):
 
 # ------------------ Benchmark Logic ------------------
 
-def benchmark_fft(method, N, runs=3, seed=0):
+def prepare_fft(method, N, runs=3, seed=0):
+    """Generate the signal for benchmark_fft() and warm up the method."""
     np.random.seed(seed)
-    x = np.random.rand(N) + 1j * np.random.rand(N)
+    x_swig = None
+    with metrics.span(f"generate N={N}"):
+        x = np.random.rand(N) + 1j * np.random.rand(N)
     
-    # Convert to SWIG ComplexVector for SWIG methods
-    if method.startswith("swig_"):
-        x_swig = fft_swig.ComplexVector()
-        for val in x:
-            x_swig.append(complex(val))
+        # Convert to SWIG ComplexVector for SWIG methods
+        if method.startswith("swig_"):
+            x_swig = fft_swig.ComplexVector()
+            for val in x:
+                x_swig.append(complex(val))
     
     # Warmup (avoid startup overheads)
     if method == "naive":
@@ -65,24 +76,35 @@ def benchmark_fft(method, N, runs=3, seed=0):
     else:
         _ = fft_numpy(x[:8])
     
+    return x, x_swig
+
+
+def benchmark_fft(method, N, runs=3, seed=0, inputs=None):
+    """Time runs transforms; inputs is the result of prepare_fft(), generated here if None."""
+    if inputs is None:
+        inputs = prepare_fft(method, N, runs, seed)
+    x, x_swig = inputs
+    
     results = []
-    for r in range(runs):
-        start = time.perf_counter()
+    label = f"{method} N={N}"
+    for r in metrics.repetitions(label, runs):
+        with metrics.measure(label):
+            start = time.perf_counter()
         
-        if method == "naive":
-            X = dft_naive(x)
-        elif method == "numpy":
-            X = fft_numpy(x)
-        elif method == "swig_naive":
-            X = fft_swig.dft_naive(x_swig)
-        elif method == "swig_recursive":
-            X = fft_swig.fft_cooley_tukey(x_swig)
-        elif method == "swig_iterative":
-            X = fft_swig.fft_iterative(x_swig)
-        else:
-            raise ValueError(f"Unknown method: {method}")
+            if method == "naive":
+                X = dft_naive(x)
+            elif method == "numpy":
+                X = fft_numpy(x)
+            elif method == "swig_naive":
+                X = fft_swig.dft_naive(x_swig)
+            elif method == "swig_recursive":
+                X = fft_swig.fft_cooley_tukey(x_swig)
+            elif method == "swig_iterative":
+                X = fft_swig.fft_iterative(x_swig)
+            else:
+                raise ValueError(f"Unknown method: {method}")
         
-        end = time.perf_counter()
+            end = time.perf_counter()
         elapsed = end - start
         
         # Approximate operation count for FFT: ~5*N*log2(N) complex ops
@@ -104,18 +126,29 @@ def benchmark_fft(method, N, runs=3, seed=0):
         
         print(f"[Run {r+1}/{runs}] {method:15s} | N={N:6d} | Time={elapsed:.6f}s | {gflops:.3f} GFLOPS-eq")
     
+    print(f"{method:15s} | N={N:6d} | Latency: {format_latency(metrics.latency(label))}")
     return results
 
 
+# ------------------ Workloads ------------------
+
+# (prepare, benchmark, arguments) of the default command line; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_fft, benchmark_fft, ("swig_iterative", 1024, 3)),
+]
+
+
 # ------------------ CLI ------------------
 
 def main():
     parser = argparse.ArgumentParser(description="FFT benchmark (Python vs NumPy vs SWIG).")
-    parser.add_argument("--size", "-n", type=int, default=1024, help="Signal size N")
-    parser.add_argument("--runs", "-r", type=int, default=3, help="Number of runs")
+    default_method, default_size, default_runs = WORKLOADS[0][2]
+    parser.add_argument("--size", "-n", type=int, default=default_size, help="Signal size N")
+    parser.add_argument("--runs", "-r", type=int, default=default_runs, help="Number of runs")
     parser.add_argument("--method", "-m", 
                        choices=["naive", "numpy", "swig_naive", "swig_recursive", "swig_iterative"], 
-                       default="swig_iterative")
+                       default=default_method)
     parser.add_argument("--output", "-o", type=str, default="", help="Optional CSV output file")
     
     args = parser.parse_args()
@@ -131,4 +164,5 @@ def main():
 
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
+    metrics.save()
\ No newline at end of file
@@ -4,7 +4,9 @@ from setuptools import setup, Extension
 fft_module = Extension(
     '_fft_swig',
     sources=['fft_swig.i', 'fft_swig.cpp'],
-    swig_opts=['-c++'],
+    swig_opts=['-c++', '-I../transfer'],  # move_result.i
+    include_dirs=['../instrument'],  # kernel_trace.h
+    libraries=['dl'],
     extra_compile_args=['-O3', '-std=c++11', '-ffast-math'],
 )
 
@@ -0,0 +1,140 @@
+// alloc_preload.cpp
+// LD_PRELOAD library that counts heap allocations of the whole process.
+// operator new/delete go through malloc/free in libstdc++, so C++ kernels
+// are covered too. Counters are read by AllocationTracker via dlsym; when
+// this library is not preloaded the tracker reports them as unavailable.
+//
+// Built by the native Makefile as build/liballoc_track.so.
+#include "allocation_tracker.h"
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <malloc.h>
+#include <stdint.h>
+#include <unistd.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+static std::atomic<long long> allocations(0);
+static std::atomic<long long> frees(0);
+static std::atomic<long long> bytes(0);
+static std::atomic<long long> live_bytes(0);
+static std::atomic<long long> peak_live_bytes(0);
+
+static void on_alloc(void* ptr, size_t requested) {
+    if (!ptr) {
+        return;
+    }
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(requested, std::memory_order_relaxed);
+    // Live bytes use the usable size so that free() can subtract the same amount
+    long long live = live_bytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed)
+                     + malloc_usable_size(ptr);
+    long long peak = peak_live_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+static void on_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    frees.fetch_add(1, std::memory_order_relaxed);
+    live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+}
+
+extern "C" {
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    on_alloc(ptr, size);
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    on_alloc(ptr, count * size);
+    return ptr;
+}
+
+void* realloc(void* old, size_t size) {
+    // Counted as a free of the old block and a new allocation
+    size_t old_usable = old ? malloc_usable_size(old) : 0;
+    void* ptr = __libc_realloc(old, size);
+    if (old && (ptr || size == 0)) {
+        frees.fetch_add(1, std::memory_order_relaxed);
+        live_bytes.fetch_sub(old_usable, std::memory_order_relaxed);
+    }
+    on_alloc(ptr, size);
+    return ptr;
+}
+
+void free(void* ptr) {
+    on_free(ptr);
+    __libc_free(ptr);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    on_alloc(ptr, size);
+    return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+void* valloc(size_t size) {
+    return memalign(sysconf(_SC_PAGESIZE), size);
+}
+
+void* pvalloc(size_t size) {
+    // Rounded up to whole pages, at least one
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t rounded = size ? (size + page - 1) & ~(page - 1) : page;
+    if (rounded < size) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    return memalign(page, rounded);
+}
+
+void* reallocarray(void* old, size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    return realloc(old, count * size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* ptr = memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *out = ptr;
+    return 0;
+}
+
+void alloc_track_read(AllocCounters* out) {
+    out->allocations = allocations.load(std::memory_order_relaxed);
+    out->frees = frees.load(std::memory_order_relaxed);
+    out->bytes = bytes.load(std::memory_order_relaxed);
+    out->live_bytes = live_bytes.load(std::memory_order_relaxed);
+    out->peak_live_bytes = peak_live_bytes.load(std::memory_order_relaxed);
+}
+
+void alloc_track_reset_peak() {
+    peak_live_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+}
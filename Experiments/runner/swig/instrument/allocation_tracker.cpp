@@ -0,0 +1,55 @@
+// allocation_tracker.cpp
+#include "allocation_tracker.h"
+#include <dlfcn.h>
+
+void AllocationSample::accumulate(const AllocationSample& other) {
+    if (other.allocations < 0) {
+        return;
+    }
+    if (allocations < 0) {
+        *this = other;
+        return;
+    }
+    allocations += other.allocations;
+    frees += other.frees;
+    bytes += other.bytes;
+    if (other.peak_bytes > peak_bytes) {
+        peak_bytes = other.peak_bytes;
+    }
+}
+
+AllocationTracker::AllocationTracker() {
+    // Resolved in the global scope, where LD_PRELOAD puts liballoc_track.so
+    read_fn = reinterpret_cast<ReadFn>(dlsym(RTLD_DEFAULT, "alloc_track_read"));
+    reset_fn = reinterpret_cast<ResetFn>(dlsym(RTLD_DEFAULT, "alloc_track_reset_peak"));
+    at_start = AllocCounters();
+}
+
+bool AllocationTracker::available() const {
+    return read_fn != 0 && reset_fn != 0;
+}
+
+void AllocationTracker::start() {
+    if (!available()) {
+        return;
+    }
+    reset_fn();
+    read_fn(&at_start);
+}
+
+AllocationSample AllocationTracker::stop() {
+    AllocationSample sample;
+    if (!available()) {
+        return sample;
+    }
+    AllocCounters now;
+    read_fn(&now);
+    sample.allocations = now.allocations - at_start.allocations;
+    sample.frees = now.frees - at_start.frees;
+    sample.bytes = now.bytes - at_start.bytes;
+    sample.peak_bytes = now.peak_live_bytes - at_start.live_bytes;
+    if (sample.peak_bytes < 0) {
+        sample.peak_bytes = 0;
+    }
+    return sample;
+}
@@ -0,0 +1,50 @@
+// allocation_tracker.h
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+// Process-wide heap counters kept by liballoc_track.so (alloc_preload.cpp)
+struct AllocCounters {
+    long long allocations;
+    long long frees;
+    long long bytes;            // requested bytes, cumulative
+    long long live_bytes;       // usable bytes currently allocated
+    long long peak_live_bytes;  // highest live_bytes since the last peak reset
+};
+
+// Heap activity during one measured region. A value of -1 means the
+// process was started without LD_PRELOAD=liballoc_track.so.
+struct AllocationSample {
+    long long allocations;
+    long long frees;
+    long long bytes;
+    long long peak_bytes;       // peak live bytes above the level at start()
+
+    AllocationSample() : allocations(-1), frees(-1), bytes(-1), peak_bytes(-1) {}
+
+    // Sum counts; keep the larger peak
+    void accumulate(const AllocationSample& other);
+};
+
+// Reads the preloaded allocation counters around a kernel call. Covers
+// every thread of the process, including allocations made by the SWIG
+// wrapper while converting arguments and results.
+class AllocationTracker {
+public:
+    AllocationTracker();
+
+    // False if liballoc_track.so is not preloaded
+    bool available() const;
+
+    void start();
+    AllocationSample stop();
+
+private:
+    typedef void (*ReadFn)(AllocCounters*);
+    typedef void (*ResetFn)();
+
+    ReadFn read_fn;
+    ResetFn reset_fn;
+    AllocCounters at_start;
+};
+
+#endif // ALLOCATION_TRACKER_H
@@ -0,0 +1,102 @@
+// cache_flush.cpp
+#include "cache_flush.h"
+#include <cstdio>
+#include <cstdlib>
+#include <stdint.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#endif
+
+static const size_t LINE_BYTES = 64;
+static const size_t MIN_BUFFER_BYTES = 16u << 20;
+
+// "32768K" or "1M" as found in /sys/devices/system/cpu/cpu0/cache/index*/size
+static size_t parse_cache_size(const char* text) {
+    char* end = NULL;
+    unsigned long value = std::strtoul(text, &end, 10);
+    if (end && (*end == 'K' || *end == 'k')) {
+        value <<= 10;
+    } else if (end && (*end == 'M' || *end == 'm')) {
+        value <<= 20;
+    }
+    return value;
+}
+
+size_t last_level_cache_bytes() {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l3 > 0) {
+        return static_cast<size_t>(l3);
+    }
+#endif
+    // Some VMs report 0 through sysconf; take the largest cache sysfs lists
+    size_t largest = 0;
+    for (int index = 0; index < 8; index++) {
+        char path[96];
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        FILE* f = std::fopen(path, "r");
+        if (!f) {
+            continue;
+        }
+        char text[32] = "";
+        if (std::fgets(text, sizeof(text), f)) {
+            size_t size = parse_cache_size(text);
+            if (size > largest) {
+                largest = size;
+            }
+        }
+        std::fclose(f);
+    }
+    return largest;
+}
+
+CacheFlusher::CacheFlusher(size_t buffer_bytes) : sink(0) {
+    if (buffer_bytes == 0) {
+        buffer_bytes = 3 * last_level_cache_bytes();
+        if (buffer_bytes < MIN_BUFFER_BYTES) {
+            buffer_bytes = MIN_BUFFER_BYTES;
+        }
+    }
+    buffer.assign(buffer_bytes, 0);
+}
+
+void CacheFlusher::flush() {
+    unsigned char* data = buffer.data();
+    size_t n = buffer.size();
+
+    // One store per line claims it in every level, the read pass keeps the
+    // lines resident so the kernel's data is what got evicted
+    for (size_t i = 0; i < n; i += LINE_BYTES) {
+        data[i] = static_cast<unsigned char>(data[i] + 1);
+    }
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < n; i += LINE_BYTES) {
+        sum += data[i];
+    }
+    sink += sum;
+    asm volatile("" : : "r"(sink) : "memory");
+}
+
+size_t CacheFlusher::buffer_bytes() const {
+    return buffer.size();
+}
+
+bool CacheFlusher::flush_range(const void* data, size_t bytes) {
+#if defined(__x86_64__) || defined(__i386__)
+    const char* p = static_cast<const char*>(data);
+    const char* end = p + bytes;
+    // Start at the line containing the first byte
+    p -= reinterpret_cast<uintptr_t>(p) % LINE_BYTES;
+    for (; p < end; p += LINE_BYTES) {
+        _mm_clflush(p);
+    }
+    _mm_mfence();
+    return true;
+#else
+    (void)data;
+    (void)bytes;
+    return false;
+#endif
+}
@@ -0,0 +1,38 @@
+// cache_flush.h
+#ifndef CACHE_FLUSH_H
+#define CACHE_FLUSH_H
+
+#include <cstddef>
+#include <vector>
+
+// Size of the largest data cache in bytes (usually the shared L3), read from
+// sysconf or /sys/devices/system/cpu; 0 if unknown
+size_t last_level_cache_bytes();
+
+// Evicts a kernel's inputs from the data caches before a cold measurement
+// by writing and then reading a buffer several times larger than the last
+// level cache. TLBs and branch predictors stay warm.
+class CacheFlusher {
+public:
+    // buffer_bytes = 0 picks 3x the last level cache (at least 16 MiB)
+    explicit CacheFlusher(size_t buffer_bytes = 0);
+
+    void flush();
+
+    size_t buffer_bytes() const;
+
+#ifndef SWIG
+    // Writes back and invalidates the cache lines of [data, data + bytes)
+    // with clflush. False where clflush is not available (non-x86).
+    static bool flush_range(const void* data, size_t bytes);
+#endif
+
+private:
+    CacheFlusher(const CacheFlusher&);
+    CacheFlusher& operator=(const CacheFlusher&);
+
+    std::vector<unsigned char> buffer;
+    unsigned long long sink;    // keeps the read pass from being optimized away
+};
+
+#endif // CACHE_FLUSH_H
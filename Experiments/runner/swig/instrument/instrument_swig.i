@@ -0,0 +1,29 @@
+/* instrument_swig.i */
+%module instrument_swig
+
+%{
+#include "perf_counters.h"
+#include "rapl_energy.h"
+#include "latency_histogram.h"
+#include "repetition_control.h"
+#include "allocation_tracker.h"
+#include "trace_spans.h"
+#include "cache_flush.h"
+%}
+
+%include "std_string.i"
+%include "std_vector.i"
+
+namespace std {
+    %template(DoubleVector) vector<double>;
+    %template(StringVector) vector<string>;
+    %template(LongLongVector) vector<long long>;
+}
+
+%include "perf_counters.h"
+%include "rapl_energy.h"
+%include "latency_histogram.h"
+%include "repetition_control.h"
+%include "allocation_tracker.h"
+%include "trace_spans.h"
+%include "cache_flush.h"
\ No newline at end of file
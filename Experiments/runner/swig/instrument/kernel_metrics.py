@@ -0,0 +1,368 @@
+"""
+Per-kernel measurements for the SWIG benchmarks.
+
+Each main.py wraps its timed kernel calls in ``metrics.measure()``, which
+reads hardware counters and the RAPL energy counters immediately around the
+call. The values are accumulated over all calls of the process and, when the runner
+sets KERNEL_METRICS_OUT, written there as JSON so RunnerConfig can add them
+to the run table.
+
+Each call is also timed on its own and recorded in a latency histogram per
+label (one label per problem size), so the JSON carries p50/p90/p99/max and
+the per-iteration samples instead of only an average.
+
+When the process runs with LD_PRELOAD=liballoc_track.so (built by the native
+Makefile), heap allocations, allocated bytes and the peak live bytes of each
+call are recorded as well.
+
+When KERNEL_TRACE_OUT is set, every measured call and every span() (for
+example input generation) is also recorded as a timeline span, together with
+the spans the kernels record themselves (kernel_trace.h), and save() writes
+them there as Chrome trace-event JSON. A "swig" span minus the "kernel" span
+nested in it is the time spent converting arguments and results.
+
+flush_caches() evicts the data caches (by sweeping a buffer larger than the
+last level cache) so the next measured call starts cold; give cold calls
+their own label so they are reported apart from the warm ones.
+
+The kernel energy sums every RAPL package unless KERNEL_METRICS_RAPL_PACKAGE
+names one socket, as parallel_scheduler.py does for runs pinned to a socket.
+
+When SWIG_DATA_HANDLES=1 (use_handles()), the benchmarks that have native
+data handles (GraphHandle, MatrixHandle, PointSetHandle, BodySystemHandle)
+build their inputs into them once, so the measured calls run on data that
+stays in C++ instead of converting Python lists or proxies on every call.
+When SWIG_BATCH_CALLS=1 (use_batched_calls()), json_bench generates all the
+strings of a dataset with one batched call instead of one call per string.
+
+repeat() calls a kernel until the bootstrap CI of its median latency is
+narrow enough (or a call/time budget runs out) instead of a fixed count, and
+records the precision it reached. The timed loops of main.py iterate over
+repetitions(label, runs), which is their fixed run count unless
+KERNEL_REPEAT_TARGET_CI is set (RunnerConfig.adaptive_repetitions); then
+they stop the way repeat() does, cycling through their prepared inputs.
+
+Without the instrument_swig module (built with python setup.py build_ext
+--inplace in runner/swig/instrument), KernelMetrics falls back to timing
+each call with perf_counter_ns: latency() and save() still work, and the
+counter, energy, allocation and trace values are None or left out.
+"""
+import json
+import math
+import os
+import sys
+import time
+from contextlib import contextmanager
+
+# The kernels look up the span recorder (trace_span_record) with dlsym, so
+# the instrumentation module has to be loaded into the global symbol scope
+_dlopen_flags = sys.getdlopenflags()
+sys.setdlopenflags(_dlopen_flags | os.RTLD_GLOBAL)
+try:
+    import instrument_swig
+except ImportError:
+    instrument_swig = None
+finally:
+    sys.setdlopenflags(_dlopen_flags)
+
+METRICS_ENV = "KERNEL_METRICS_OUT"
+TRACE_ENV = "KERNEL_TRACE_OUT"
+HANDLES_ENV = "SWIG_DATA_HANDLES"
+BATCH_ENV = "SWIG_BATCH_CALLS"
+RAPL_PACKAGE_ENV = "KERNEL_METRICS_RAPL_PACKAGE"
+REPEAT_ENV = "KERNEL_REPEAT_TARGET_CI"
+
+# Run table columns filled from the metrics file
+COUNTER_COLUMNS = ["cycles", "instructions", "ipc", "l1d_misses", "llc_misses", "branch_misses"]
+ENERGY_COLUMNS = ["kernel_energy_j", "kernel_energy_per_call_j", "kernel_dram_energy_j"]
+ALLOCATION_COLUMNS = ["kernel_allocations_per_call", "kernel_alloc_bytes_per_call", "kernel_peak_alloc_bytes"]
+
+
+def _counter(value):
+    """Map the -1 'unavailable' marker to None."""
+    return value if value >= 0 else None
+
+
+def _joules(value):
+    return round(value, 6) if value >= 0 else None
+
+
+def _ms(ns):
+    return round(ns / 1e6, 6)
+
+
+def use_handles():
+    """True when the run keeps kernel inputs in native data handles."""
+    return os.environ.get(HANDLES_ENV) == "1"
+
+
+def use_batched_calls():
+    """True when the run replaces repeated small kernel calls with one batched call."""
+    return os.environ.get(BATCH_ENV) == "1"
+
+
+def rapl_package():
+    """Socket whose RAPL domains are read: KERNEL_METRICS_RAPL_PACKAGE, or -1 for all."""
+    return int(os.environ.get(RAPL_PACKAGE_ENV, "-1"))
+
+
+def format_latency(latency):
+    """One-line summary of a KernelMetrics.latency() dict."""
+    return (f"p50 {latency['p50_ms']:.4f} ms | p90 {latency['p90_ms']:.4f} ms | "
+            f"p99 {latency['p99_ms']:.4f} ms | max {latency['max_ms']:.4f} ms")
+
+
+class KernelMetrics:
+    def __init__(self):
+        self._counters = instrument_swig.PerfCounters()
+        self._totals = instrument_swig.PerfSample()
+        self._energy = instrument_swig.RaplEnergy("/sys/class/powercap", rapl_package())
+        self._joules = instrument_swig.EnergyReading()
+        self._heap = instrument_swig.AllocationTracker()
+        self._allocations = {}  # label -> [calls, AllocationSample]
+        self._latency = {}      # label -> LatencyRecorder
+        self._precision = {}    # label -> result of repeat()
+        self._flusher = None    # created on the first flush_caches()
+        self._last_ns = {}      # label -> latency of its last measured call
+        self.calls = 0
+        if os.environ.get(TRACE_ENV):
+            instrument_swig.trace_thread_name("python")
+            instrument_swig.trace_enable(True)
+
+    @contextmanager
+    def measure(self, label="kernel"):
+        """Count hardware events, RAPL energy and latency for the enclosed kernel call."""
+        recorder = self._latency.get(label)
+        if recorder is None:
+            recorder = self._latency[label] = instrument_swig.LatencyRecorder()
+        self._heap.start()
+        self._counters.start()
+        self._energy.start()
+        # Innermost, so the latency excludes the counter reads
+        recorder.start()
+        try:
+            yield
+        finally:
+            self._last_ns[label] = recorder.stop()
+            if instrument_swig.trace_enabled():
+                end = instrument_swig.now_ns()
+                instrument_swig.trace_record("swig", label, end - self._last_ns[label], end)
+            self._joules.accumulate(self._energy.stop())
+            self._totals.accumulate(self._counters.stop())
+            if self._heap.available():
+                entry = self._allocations.setdefault(label, [0, instrument_swig.AllocationSample()])
+                entry[0] += 1
+                entry[1].accumulate(self._heap.stop())
+            self.calls += 1
+
+    @contextmanager
+    def span(self, name, category="python"):
+        """Record the enclosed block (e.g. input generation) on the trace timeline."""
+        if not instrument_swig.trace_enabled():
+            yield
+            return
+        start = instrument_swig.now_ns()
+        try:
+            yield
+        finally:
+            instrument_swig.trace_record(category, name, start, instrument_swig.now_ns())
+
+    def flush_caches(self):
+        """Evict the data caches before a cold measurement (outside measure())."""
+        if self._flusher is None:
+            self._flusher = instrument_swig.CacheFlusher()
+        self._flusher.flush()
+
+    def latency(self, label="kernel"):
+        """Latency distribution of the calls measured under label, in ms."""
+        recorder = self._latency.get(label)
+        if recorder is None:
+            return None
+        hist = recorder.histogram()
+        return {
+            "count": hist.count(),
+            "mean_ms": _ms(hist.mean()),
+            "min_ms": _ms(hist.min()),
+            "p50_ms": _ms(hist.percentile(50)),
+            "p90_ms": _ms(hist.percentile(90)),
+            "p99_ms": _ms(hist.percentile(99)),
+            "max_ms": _ms(hist.max()),
+        }
+
+    def allocations(self, label="kernel"):
+        """Heap activity per call under label, or None without the preloaded tracker."""
+        entry = self._allocations.get(label)
+        if entry is None:
+            return None
+        calls, sample = entry
+        return {
+            "allocations_per_call": round(sample.allocations / calls, 3),
+            "bytes_per_call": round(sample.bytes / calls, 1),
+            "peak_bytes": sample.peak_bytes,
+        }
+
+    def repeat(self, label, call, target_ci=0.05, min_runs=5, max_runs=1000, time_budget_s=10.0):
+        """Run call() under measure(label) until the 95% CI of the median is within target_ci."""
+        for _ in self._until_precise(label, target_ci, min_runs, max_runs, time_budget_s):
+            with self.measure(label):
+                call()
+        return self._precision[label]
+
+    def repetitions(self, label, runs):
+        """Run indices for a timed loop whose body measures label once per run:
+        range(runs), or as many as repeat() would make with KERNEL_REPEAT_TARGET_CI set."""
+        target_ci = os.environ.get(REPEAT_ENV)
+        if not target_ci:
+            return range(runs)
+        return self._until_precise(label, float(target_ci))
+
+    def _until_precise(self, label, target_ci, min_runs=5, max_runs=1000, time_budget_s=10.0):
+        controller = instrument_swig.RepetitionController(target_ci, min_runs, max_runs, time_budget_s)
+        run = 0
+        while True:
+            yield run
+            run += 1
+            if not controller.add(self._last_ns[label]):
+                break
+
+        ci = controller.interval()
+        self._precision[label] = {
+            "runs": ci.samples,
+            "median_ms": _ms(ci.median),
+            "ci_low_ms": _ms(ci.low),
+            "ci_high_ms": _ms(ci.high),
+            "ci_relative_width": round(ci.relative_width(), 6),
+            "stop_reason": controller.stop_reason(),
+        }
+
+    def as_dict(self):
+        totals = self._totals
+        heap_calls = sum(calls for calls, _ in self._allocations.values())
+        heap = instrument_swig.AllocationSample()
+        for _, sample in self._allocations.values():
+            heap.accumulate(sample)
+        return {
+            "kernel_calls": self.calls,
+            "cycles": _counter(totals.cycles),
+            "instructions": _counter(totals.instructions),
+            "ipc": round(totals.ipc(), 3) if totals.cycles > 0 else None,
+            "l1d_misses": _counter(totals.l1d_misses),
+            "llc_misses": _counter(totals.llc_misses),
+            "branch_misses": _counter(totals.branch_misses),
+            # False: counters covered only the Python thread, not kernel workers
+            "counters_include_threads": self._counters.counts_threads(),
+            "kernel_energy_j": _joules(self._joules.package_j),
+            "kernel_energy_per_call_j": _joules(self._joules.package_j / self.calls)
+                                        if self.calls and self._joules.package_j >= 0 else None,
+            "kernel_dram_energy_j": _joules(self._joules.dram_j),
+            "kernel_allocations_per_call": round(heap.allocations / heap_calls, 3) if heap_calls else None,
+            "kernel_alloc_bytes_per_call": round(heap.bytes / heap_calls, 1) if heap_calls else None,
+            "kernel_peak_alloc_bytes": heap.peak_bytes if heap_calls else None,
+            "allocations": {label: self.allocations(label) for label in self._allocations},
+            "latency": {
+                label: dict(self.latency(label), samples_ms=[_ms(ns) for ns in recorder.samples()])
+                for label, recorder in self._latency.items()
+            },
+            "precision": self._precision,
+        }
+
+    def save(self, path=None):
+        """Write the accumulated metrics to path or $KERNEL_METRICS_OUT, and the trace to $KERNEL_TRACE_OUT."""
+        trace_path = os.environ.get(TRACE_ENV)
+        if trace_path and instrument_swig.trace_enabled():
+            instrument_swig.trace_write_json(trace_path)
+        path = path or os.environ.get(METRICS_ENV)
+        if not path:
+            return
+        with open(path, "w") as f:
+            json.dump(self.as_dict(), f, indent=2)
+
+
+class _TimingOnlyMetrics:
+    """KernelMetrics without instrument_swig: the same interface, latency only."""
+
+    def __init__(self):
+        self._samples = {}      # label -> [ns, ...]
+        self._precision = {}
+        self.calls = 0
+
+    @contextmanager
+    def measure(self, label="kernel"):
+        start = time.perf_counter_ns()
+        try:
+            yield
+        finally:
+            self._samples.setdefault(label, []).append(time.perf_counter_ns() - start)
+            self.calls += 1
+
+    @contextmanager
+    def span(self, name, category="python"):
+        yield
+
+    def flush_caches(self):
+        pass
+
+    def latency(self, label="kernel"):
+        samples = self._samples.get(label)
+        if not samples:
+            return None
+        ordered = sorted(samples)
+
+        def percentile(p):
+            return ordered[min(len(ordered) - 1, max(0, math.ceil(p / 100 * len(ordered)) - 1))]
+
+        return {
+            "count": len(ordered),
+            "mean_ms": _ms(sum(ordered) / len(ordered)),
+            "min_ms": _ms(ordered[0]),
+            "p50_ms": _ms(percentile(50)),
+            "p90_ms": _ms(percentile(90)),
+            "p99_ms": _ms(percentile(99)),
+            "max_ms": _ms(ordered[-1]),
+        }
+
+    def allocations(self, label="kernel"):
+        return None
+
+    def repeat(self, label, call, target_ci=0.05, min_runs=5, max_runs=1000, time_budget_s=10.0):
+        """Without the bootstrap controller: min_runs calls, no precision estimate."""
+        for _ in range(min_runs):
+            with self.measure(label):
+                call()
+        self._precision[label] = {
+            "runs": min_runs,
+            "median_ms": self.latency(label)["p50_ms"],
+            "ci_low_ms": None,
+            "ci_high_ms": None,
+            "ci_relative_width": None,
+            "stop_reason": "uninstrumented",
+        }
+        return self._precision[label]
+
+    def repetitions(self, label, runs):
+        """Always range(runs): the adaptive count needs instrument_swig."""
+        return range(runs)
+
+    def as_dict(self):
+        metrics = {"kernel_calls": self.calls}
+        for column in COUNTER_COLUMNS + ENERGY_COLUMNS + ALLOCATION_COLUMNS:
+            metrics[column] = None
+        metrics["counters_include_threads"] = None
+        metrics["allocations"] = {}
+        metrics["latency"] = {
+            label: dict(self.latency(label), samples_ms=[_ms(ns) for ns in samples])
+            for label, samples in self._samples.items()
+        }
+        metrics["precision"] = self._precision
+        return metrics
+
+    def save(self, path=None):
+        path = path or os.environ.get(METRICS_ENV)
+        if not path:
+            return
+        with open(path, "w") as f:
+            json.dump(self.as_dict(), f, indent=2)
+
+
+if instrument_swig is None:
+    KernelMetrics = _TimingOnlyMetrics
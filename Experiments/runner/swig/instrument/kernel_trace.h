@@ -0,0 +1,86 @@
+// kernel_trace.h
+#ifndef KERNEL_TRACE_H
+#define KERNEL_TRACE_H
+
+// Trace spans inside the kernels, for the timeline of trace_spans.h.
+//
+//     KERNEL_TRACE_SPAN("bfs");     // covers the rest of the enclosing scope
+//
+// The kernels do not link the instrumentation: the recorder
+// (trace_span_record) and its enabled flag (trace_span_enabled) are looked
+// up in the global symbol scope on first use, like the allocation counters.
+// Without them, or with tracing disabled, a span costs a branch and a
+// relaxed load; the clock is read only while tracing.
+// Define NO_KERNEL_TRACE to compile the spans out entirely.
+
+#ifdef NO_KERNEL_TRACE
+
+#define KERNEL_TRACE_SPAN(name) do { } while (0)
+
+#else
+
+#include <atomic>
+#include <dlfcn.h>
+#include <time.h>
+
+typedef void (*KernelTraceSink)(const char* category, const char* name,
+                                long long start_ns, long long end_ns);
+
+struct KernelTraceHooks {
+    KernelTraceSink sink;
+    const std::atomic<bool>* enabled;
+};
+
+inline KernelTraceHooks kernel_trace_lookup() {
+    KernelTraceHooks hooks;
+    hooks.sink = reinterpret_cast<KernelTraceSink>(dlsym(RTLD_DEFAULT, "trace_span_record"));
+    hooks.enabled = static_cast<const std::atomic<bool>*>(dlsym(RTLD_DEFAULT, "trace_span_enabled"));
+    if (!hooks.enabled) {
+        hooks.sink = NULL;
+    }
+    return hooks;
+}
+
+// The recorder if tracing is on, NULL otherwise
+inline KernelTraceSink kernel_trace_sink() {
+    static const KernelTraceHooks hooks = kernel_trace_lookup();
+    if (!hooks.sink || !hooks.enabled->load(std::memory_order_relaxed)) {
+        return NULL;
+    }
+    return hooks.sink;
+}
+
+// Same clock as now_ns() in latency_histogram.h
+inline long long kernel_trace_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+class KernelTraceSpan {
+public:
+    explicit KernelTraceSpan(const char* name)
+        : name(name), sink(kernel_trace_sink()), start_ns(sink ? kernel_trace_now() : 0) {}
+
+    ~KernelTraceSpan() {
+        if (sink) {
+            sink("kernel", name, start_ns, kernel_trace_now());
+        }
+    }
+
+private:
+    KernelTraceSpan(const KernelTraceSpan&);
+    KernelTraceSpan& operator=(const KernelTraceSpan&);
+
+    const char* name;
+    KernelTraceSink sink;
+    long long start_ns;
+};
+
+#define KERNEL_TRACE_CONCAT_(a, b) a##b
+#define KERNEL_TRACE_CONCAT(a, b) KERNEL_TRACE_CONCAT_(a, b)
+#define KERNEL_TRACE_SPAN(name) KernelTraceSpan KERNEL_TRACE_CONCAT(kernel_trace_span_, __LINE__)(name)
+
+#endif // NO_KERNEL_TRACE
+
+#endif // KERNEL_TRACE_H
@@ -0,0 +1,133 @@
+// latency_histogram.cpp
+#include "latency_histogram.h"
+#include <time.h>
+
+static const int LINEAR_BUCKETS = 128;      // one bucket per ns below this
+static const int SUB_BUCKET_BITS = 6;       // 64 sub-buckets per power of two
+static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+static const int NUM_BUCKETS = LINEAR_BUCKETS + (63 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+long long now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static int bucket_index(long long value) {
+    if (value < LINEAR_BUCKETS) {
+        return static_cast<int>(value);
+    }
+    int msb = 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+    int shift = msb - SUB_BUCKET_BITS;     // value >> shift is in [64, 128)
+    int sub = static_cast<int>(value >> shift) - SUB_BUCKETS;
+    return LINEAR_BUCKETS + (shift - 1) * SUB_BUCKETS + sub;
+}
+
+// Midpoint of the value range a bucket covers
+static long long bucket_value(int index) {
+    if (index < LINEAR_BUCKETS) {
+        return index;
+    }
+    int shift = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 1;
+    long long sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+    long long low = sub << shift;
+    return low + ((1LL << shift) >> 1);
+}
+
+LatencyHistogram::LatencyHistogram()
+    : counts(NUM_BUCKETS, 0), total(0), min_ns(0), max_ns(0), sum_ns(0.0) {}
+
+void LatencyHistogram::record(long long ns) {
+    if (ns < 0) {
+        ns = 0;
+    }
+    counts[bucket_index(ns)]++;
+    if (total == 0 || ns < min_ns) min_ns = ns;
+    if (ns > max_ns) max_ns = ns;
+    sum_ns += ns;
+    total++;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) {
+        return;
+    }
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        counts[i] += other.counts[i];
+    }
+    if (total == 0 || other.min_ns < min_ns) min_ns = other.min_ns;
+    if (other.max_ns > max_ns) max_ns = other.max_ns;
+    sum_ns += other.sum_ns;
+    total += other.total;
+}
+
+void LatencyHistogram::reset() {
+    counts.assign(NUM_BUCKETS, 0);
+    total = 0;
+    min_ns = max_ns = 0;
+    sum_ns = 0.0;
+}
+
+long long LatencyHistogram::count() const {
+    return total;
+}
+
+long long LatencyHistogram::min() const {
+    return min_ns;
+}
+
+long long LatencyHistogram::max() const {
+    return max_ns;
+}
+
+double LatencyHistogram::mean() const {
+    return total ? sum_ns / total : 0.0;
+}
+
+long long LatencyHistogram::percentile(double p) const {
+    if (total == 0) {
+        return 0;
+    }
+    if (p >= 100.0) {
+        return max_ns;
+    }
+
+    // Smallest bucket whose cumulative count reaches rank
+    long long rank = static_cast<long long>(p / 100.0 * total + 0.5);
+    if (rank < 1) rank = 1;
+    long long seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            long long value = bucket_value(i);
+            return value < min_ns ? min_ns : (value > max_ns ? max_ns : value);
+        }
+    }
+    return max_ns;
+}
+
+LatencyRecorder::LatencyRecorder() : start_ns(0) {}
+
+void LatencyRecorder::start() {
+    start_ns = now_ns();
+}
+
+long long LatencyRecorder::stop() {
+    long long elapsed = now_ns() - start_ns;
+    hist.record(elapsed);
+    sample_ns.push_back(elapsed);
+    return elapsed;
+}
+
+const LatencyHistogram& LatencyRecorder::histogram() const {
+    return hist;
+}
+
+std::vector<long long> LatencyRecorder::samples() const {
+    return sample_ns;
+}
+
+void LatencyRecorder::reset() {
+    hist.reset();
+    sample_ns.clear();
+}
@@ -0,0 +1,62 @@
+// latency_histogram.h
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+
+// Monotonic timestamp in nanoseconds (CLOCK_MONOTONIC_RAW, read via the vDSO)
+long long now_ns();
+
+// HDR-style histogram of nanosecond latencies. Values below 128 ns get one
+// bucket each; above that every power of two is split into 64 linear
+// sub-buckets, so a reported percentile is within 1/64 (1.6%) of the true
+// value while the whole 1 ns .. 2^63 ns range needs under 4k counters.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(long long ns);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    long long count() const;
+    long long min() const;      // 0 when empty
+    long long max() const;
+    double mean() const;
+
+    // Value at percentile p (0..100), clamped to [min, max]; 0 when empty
+    long long percentile(double p) const;
+
+private:
+    std::vector<long long> counts;
+    long long total;
+    long long min_ns;
+    long long max_ns;
+    double sum_ns;
+};
+
+// Times individual kernel calls: start()/stop() around each call records
+// one sample into the histogram and keeps it for per-iteration export.
+class LatencyRecorder {
+public:
+    LatencyRecorder();
+
+    void start();
+
+    // Records and returns the nanoseconds since start()
+    long long stop();
+
+    const LatencyHistogram& histogram() const;
+
+    // Every recorded sample, in call order
+    std::vector<long long> samples() const;
+
+    void reset();
+
+private:
+    LatencyHistogram hist;
+    std::vector<long long> sample_ns;
+    long long start_ns;
+};
+
+#endif // LATENCY_HISTOGRAM_H
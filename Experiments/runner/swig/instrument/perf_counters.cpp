@@ -0,0 +1,194 @@
+// perf_counters.cpp
+#include "perf_counters.h"
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const int NUM_EVENTS = 5;
+
+static long perf_event_open(struct perf_event_attr* attr, pid_t pid, int cpu,
+                            int group_fd, unsigned long flags) {
+    return syscall(__NR_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+// Event (type, config) for each PerfSample field, in declaration order
+static void event_config(int index, unsigned int& type, unsigned long long& config) {
+    switch (index) {
+    case 0:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case 1:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case 2:
+        type = PERF_TYPE_HW_CACHE;
+        config = PERF_COUNT_HW_CACHE_L1D |
+                 (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case 3:
+        // The generic cache-misses event counts last level cache misses
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    default:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    }
+}
+
+static long long* sample_field(PerfSample& sample, int index) {
+    switch (index) {
+    case 0: return &sample.cycles;
+    case 1: return &sample.instructions;
+    case 2: return &sample.l1d_misses;
+    case 3: return &sample.llc_misses;
+    default: return &sample.branch_misses;
+    }
+}
+
+double PerfSample::ipc() const {
+    if (cycles <= 0 || instructions < 0) {
+        return 0.0;
+    }
+    return static_cast<double>(instructions) / cycles;
+}
+
+void PerfSample::accumulate(const PerfSample& other) {
+    const long long* src[] = {&other.cycles, &other.instructions, &other.l1d_misses,
+                              &other.llc_misses, &other.branch_misses};
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        long long* dst = sample_field(*this, i);
+        if (*src[i] < 0) {
+            continue;
+        }
+        *dst = (*dst < 0) ? *src[i] : *dst + *src[i];
+    }
+}
+
+PerfCounters::PerfCounters()
+    : leader_fd(-1), inherit(true), fds(NUM_EVENTS, -1), ids(NUM_EVENTS, 0),
+      start_values(NUM_EVENTS, 0), start_enabled(0), start_running(0) {
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        event_config(i, attr.type, attr.config);
+        attr.disabled = (leader_fd == -1) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Count worker threads the kernel starts (matmul, bfs, the async pool)
+        attr.inherit = inherit ? 1 : 0;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                           PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = static_cast<int>(perf_event_open(&attr, 0, -1, leader_fd, 0));
+        if (fd < 0 && inherit && leader_fd == -1) {
+            // Some kernels refuse inherited groups; fall back to this thread
+            inherit = false;
+            attr.inherit = 0;
+            fd = static_cast<int>(perf_event_open(&attr, 0, -1, leader_fd, 0));
+        }
+        if (fd < 0) {
+            // Unsupported or not permitted; report this event as unavailable
+            continue;
+        }
+
+        if (ioctl(fd, PERF_EVENT_IOC_ID, &ids[i]) != 0) {
+            close(fd);
+            continue;
+        }
+
+        fds[i] = fd;
+        if (leader_fd == -1) {
+            leader_fd = fd;
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+}
+
+bool PerfCounters::available() const {
+    return leader_fd >= 0;
+}
+
+bool PerfCounters::counts_threads() const {
+    return leader_fd >= 0 && inherit;
+}
+
+bool PerfCounters::read_group(std::vector<unsigned long long>& values,
+                              unsigned long long& enabled, unsigned long long& running) const {
+    // Layout for PERF_FORMAT_GROUP with ids and enabled/running times
+    unsigned long long buf[3 + 2 * NUM_EVENTS];
+    ssize_t n = read(leader_fd, buf, sizeof(buf));
+    if (n < static_cast<ssize_t>(3 * sizeof(unsigned long long))) {
+        return false;
+    }
+
+    unsigned long long nr = buf[0];
+    enabled = buf[1];
+    running = buf[2];
+    values.assign(NUM_EVENTS, 0);
+    for (unsigned long long e = 0; e < nr && e < NUM_EVENTS; e++) {
+        unsigned long long value = buf[3 + 2 * e];
+        unsigned long long id = buf[4 + 2 * e];
+        for (int i = 0; i < NUM_EVENTS; i++) {
+            if (fds[i] >= 0 && ids[i] == id) {
+                values[i] = value;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// Counts are taken as differences of two reads rather than reset to zero:
+// PERF_EVENT_IOC_RESET does not clear what exited inherited threads have
+// already folded into the parent counter.
+void PerfCounters::start() {
+    if (leader_fd < 0) {
+        return;
+    }
+    read_group(start_values, start_enabled, start_running);
+    ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+    if (leader_fd < 0) {
+        return sample;
+    }
+    ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    std::vector<unsigned long long> values;
+    unsigned long long enabled = 0;
+    unsigned long long running = 0;
+    if (!read_group(values, enabled, running)) {
+        return sample;
+    }
+    enabled -= start_enabled;
+    running -= start_running;
+
+    // Scale up if the kernel had to multiplex the group
+    double scale = (running > 0 && running < enabled)
+                   ? static_cast<double>(enabled) / running : 1.0;
+
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            *sample_field(sample, i) = static_cast<long long>((values[i] - start_values[i]) * scale);
+        }
+    }
+
+    return sample;
+}
@@ -0,0 +1,66 @@
+// perf_counters.h
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <vector>
+
+// Counter values for one measured region. A value of -1 means the event
+// is not available on this machine (or was denied by perf_event_paranoid).
+struct PerfSample {
+    long long cycles;
+    long long instructions;
+    long long l1d_misses;
+    long long llc_misses;
+    long long branch_misses;
+
+    PerfSample()
+        : cycles(-1), instructions(-1), l1d_misses(-1), llc_misses(-1), branch_misses(-1) {}
+
+    // Instructions per cycle, 0 if either counter is unavailable
+    double ipc() const;
+
+    // Add the available counters of another sample
+    void accumulate(const PerfSample& other);
+};
+
+// Hardware counters for the calling thread and the threads it creates after
+// construction (perf inherit), opened as one perf_event group so all events
+// are started, stopped and read together. Threads that already exist, such
+// as a pool started earlier, are not counted.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    // False if no counter could be opened
+    bool available() const;
+
+    // False if the kernel refused inherited counters and only the calling
+    // thread is counted, so threaded kernels are undercounted
+    bool counts_threads() const;
+
+    // Enable the counters and read their starting values
+    void start();
+
+    // Disable the counters and return the counts since start()
+    PerfSample stop();
+
+private:
+    PerfCounters(const PerfCounters&);
+    PerfCounters& operator=(const PerfCounters&);
+
+    // Current group values in PerfSample field order, with the enabled and
+    // running times; false if the read failed
+    bool read_group(std::vector<unsigned long long>& values,
+                    unsigned long long& enabled, unsigned long long& running) const;
+
+    int leader_fd;
+    bool inherit;
+    std::vector<int> fds;       // one entry per PerfSample field, -1 if missing
+    std::vector<unsigned long long> ids;
+    std::vector<unsigned long long> start_values;
+    unsigned long long start_enabled;
+    unsigned long long start_running;
+};
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,199 @@
+// rapl_energy.cpp
+#include "rapl_energy.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+
+static bool read_text(const std::string& path, std::string& value) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        return false;
+    }
+    std::getline(file, value);
+    return true;
+}
+
+static bool read_ull(const std::string& path, unsigned long long& value) {
+    std::string text;
+    if (!read_text(path, text) || text.empty()) {
+        return false;
+    }
+    value = std::strtoull(text.c_str(), NULL, 10);
+    return true;
+}
+
+// "package-0" -> "package", "dram" -> "dram"
+static std::string domain_kind(const std::string& name) {
+    if (name.compare(0, 8, "package-") == 0) {
+        return "package";
+    }
+    return name;
+}
+
+static void add_field(double& total, double value) {
+    total = (total < 0) ? value : total + value;
+}
+
+void EnergyReading::accumulate(const EnergyReading& other) {
+    if (other.package_j >= 0) add_field(package_j, other.package_j);
+    if (other.core_j >= 0) add_field(core_j, other.core_j);
+    if (other.uncore_j >= 0) add_field(uncore_j, other.uncore_j);
+    if (other.dram_j >= 0) add_field(dram_j, other.dram_j);
+}
+
+RaplEnergy::RaplEnergy(const std::string& root, int package) {
+    DIR* dir = opendir(root.c_str());
+    if (!dir) {
+        return;
+    }
+
+    // Zones are listed flat: intel-rapl:0 (package), intel-rapl:0:0 (subzone), ...
+    std::vector<std::string> zones;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        std::string zone = entry->d_name;
+        if (zone.compare(0, 11, "intel-rapl:") == 0) {
+            zones.push_back(zone);
+        }
+    }
+    closedir(dir);
+    std::sort(zones.begin(), zones.end());
+
+    std::string package_name;
+    if (package >= 0) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "package-%d", package);
+        package_name = buf;
+    }
+
+    for (size_t i = 0; i < zones.size(); i++) {
+        std::string base = root + "/" + zones[i];
+        std::string name;
+        if (!read_text(base + "/name", name)) {
+            continue;
+        }
+
+        // psys covers the whole platform and overlaps the package domains
+        std::string kind = domain_kind(name);
+        if (kind != "package" && kind != "core" && kind != "uncore" && kind != "dram") {
+            continue;
+        }
+
+        size_t sub = zones[i].find(':', 11);
+        std::string top = name;
+        if (sub != std::string::npos) {
+            std::string parent;
+            if (read_text(root + "/" + zones[i].substr(0, sub) + "/name", parent)) {
+                name = parent + "/" + name;
+                top = parent;
+            }
+        }
+        if (!package_name.empty() && top != package_name) {
+            continue;
+        }
+
+        Domain domain;
+        domain.name = name;
+        domain.kind = kind;
+        domain.start_uj = 0;
+        domain.last_j = 0.0;
+        if (!read_ull(base + "/max_energy_range_uj", domain.max_range_uj)) {
+            domain.max_range_uj = 0;
+        }
+
+        domain.fd = open((base + "/energy_uj").c_str(), O_RDONLY);
+        unsigned long long probe;
+        if (domain.fd < 0 || !read_uj(domain, probe)) {
+            if (domain.fd >= 0) {
+                close(domain.fd);
+            }
+            continue;
+        }
+        domains.push_back(domain);
+    }
+}
+
+RaplEnergy::~RaplEnergy() {
+    for (size_t i = 0; i < domains.size(); i++) {
+        close(domains[i].fd);
+    }
+}
+
+bool RaplEnergy::available() const {
+    return !domains.empty();
+}
+
+bool RaplEnergy::read_uj(const Domain& domain, unsigned long long& value) const {
+    char buf[32];
+    ssize_t n = pread(domain.fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) {
+        return false;
+    }
+    buf[n] = '\0';
+    value = std::strtoull(buf, NULL, 10);
+    return true;
+}
+
+void RaplEnergy::start() {
+    for (size_t i = 0; i < domains.size(); i++) {
+        read_uj(domains[i], domains[i].start_uj);
+    }
+}
+
+EnergyReading RaplEnergy::stop() {
+    EnergyReading reading;
+
+    for (size_t i = 0; i < domains.size(); i++) {
+        Domain& domain = domains[i];
+        unsigned long long end_uj;
+        if (!read_uj(domain, end_uj)) {
+            domain.last_j = -1.0;
+            continue;
+        }
+
+        // The counter runs from 0 to max_energy_range_uj inclusive and then
+        // wraps; without a known range a wrapped delta cannot be recovered
+        unsigned long long delta_uj;
+        if (end_uj >= domain.start_uj) {
+            delta_uj = end_uj - domain.start_uj;
+        } else if (domain.max_range_uj > 0) {
+            delta_uj = domain.max_range_uj - domain.start_uj + end_uj + 1;
+        } else {
+            domain.last_j = -1.0;
+            continue;
+        }
+        domain.last_j = delta_uj / 1e6;
+
+        if (domain.kind == "package") {
+            add_field(reading.package_j, domain.last_j);
+        } else if (domain.kind == "core") {
+            add_field(reading.core_j, domain.last_j);
+        } else if (domain.kind == "uncore") {
+            add_field(reading.uncore_j, domain.last_j);
+        } else {
+            add_field(reading.dram_j, domain.last_j);
+        }
+    }
+
+    return reading;
+}
+
+std::vector<std::string> RaplEnergy::domain_names() const {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < domains.size(); i++) {
+        names.push_back(domains[i].name);
+    }
+    return names;
+}
+
+std::vector<double> RaplEnergy::domain_joules() const {
+    std::vector<double> joules;
+    for (size_t i = 0; i < domains.size(); i++) {
+        joules.push_back(domains[i].last_j);
+    }
+    return joules;
+}
@@ -0,0 +1,68 @@
+// rapl_energy.h
+#ifndef RAPL_ENERGY_H
+#define RAPL_ENERGY_H
+
+#include <string>
+#include <vector>
+
+// Energy used during one measured region, in joules. Each field is summed
+// over the sockets read; -1 means the machine has no such RAPL domain.
+struct EnergyReading {
+    double package_j;
+    double core_j;
+    double uncore_j;
+    double dram_j;
+
+    EnergyReading() : package_j(-1), core_j(-1), uncore_j(-1), dram_j(-1) {}
+
+    // Add the available fields of another reading
+    void accumulate(const EnergyReading& other);
+};
+
+// Reads the Linux powercap RAPL counters (/sys/class/powercap/intel-rapl:*)
+// directly before and after a region. The counters are cumulative
+// microjoules that wrap at max_energy_range_uj, which is handled here.
+// The hardware updates them roughly every millisecond, so regions much
+// shorter than that should be batched. Reading energy_uj usually needs root.
+// A package >= 0 keeps only the domains of that socket (package-<package>
+// and its subzones), for runs pinned to one socket; -1 reads all of them.
+class RaplEnergy {
+public:
+    explicit RaplEnergy(const std::string& root = "/sys/class/powercap", int package = -1);
+    ~RaplEnergy();
+
+    // False if no readable RAPL domain was found
+    bool available() const;
+
+    // Snapshot all domain counters
+    void start();
+
+    // Energy per domain kind since start()
+    EnergyReading stop();
+
+    // Domain names such as "package-0" or "package-0/dram"
+    std::vector<std::string> domain_names() const;
+
+    // Per-domain joules of the last stop(), in domain_names() order; -1 for a
+    // domain that could not be read or wrapped with an unknown range
+    std::vector<double> domain_joules() const;
+
+private:
+    RaplEnergy(const RaplEnergy&);
+    RaplEnergy& operator=(const RaplEnergy&);
+
+    struct Domain {
+        std::string name;
+        std::string kind;           // package, core, uncore or dram
+        int fd;                     // open energy_uj file
+        unsigned long long max_range_uj;
+        unsigned long long start_uj;
+        double last_j;
+    };
+
+    bool read_uj(const Domain& domain, unsigned long long& value) const;
+
+    std::vector<Domain> domains;
+};
+
+#endif // RAPL_ENERGY_H
@@ -0,0 +1,104 @@
+// repetition_control.cpp
+#include "repetition_control.h"
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+static double median_of(std::vector<double>& values) {
+    size_t n = values.size();
+    size_t mid = n / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double upper = values[mid];
+    if (n % 2) {
+        return upper;
+    }
+    double lower = *std::max_element(values.begin(), values.begin() + mid);
+    return 0.5 * (lower + upper);
+}
+
+double MedianInterval::relative_width() const {
+    if (samples < 2 || median == 0.0) {
+        return 0.0;
+    }
+    return (high - low) / std::fabs(median);
+}
+
+MedianInterval bootstrap_median_ci(const std::vector<double>& samples, double confidence,
+                                   int resamples, unsigned int seed) {
+    MedianInterval ci;
+    ci.samples = static_cast<long>(samples.size());
+    if (samples.empty()) {
+        return ci;
+    }
+
+    std::vector<double> work = samples;
+    ci.median = ci.low = ci.high = median_of(work);
+    if (samples.size() < 2 || resamples < 1) {
+        return ci;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, samples.size() - 1);
+    std::vector<double> medians(resamples);
+    for (int b = 0; b < resamples; b++) {
+        for (size_t i = 0; i < work.size(); i++) {
+            work[i] = samples[pick(rng)];
+        }
+        medians[b] = median_of(work);
+    }
+
+    std::sort(medians.begin(), medians.end());
+    double tail = (1.0 - confidence) / 2.0;
+    size_t lo = static_cast<size_t>(std::floor(tail * (resamples - 1)));
+    size_t hi = static_cast<size_t>(std::ceil((1.0 - tail) * (resamples - 1)));
+    ci.low = medians[lo];
+    ci.high = medians[std::min(hi, medians.size() - 1)];
+    return ci;
+}
+
+RepetitionController::RepetitionController(double target_relative_width, int min_samples,
+                                           int max_samples, double time_budget_s, double confidence)
+    : target(target_relative_width), min_count(std::max(2, min_samples)),
+      max_count(std::max(min_count, max_samples)), budget_ns(time_budget_s * 1e9),
+      confidence(confidence), start_ns(now_ns()), next_check(0), reason("running") {}
+
+bool RepetitionController::add(double value) {
+    if (reason != "running") {
+        return false;
+    }
+    values.push_back(value);
+
+    if (values.size() >= static_cast<size_t>(max_count)) {
+        reason = "max_samples";
+    } else if (budget_ns > 0 && now_ns() - start_ns >= budget_ns) {
+        reason = "time_budget";
+    }
+
+    bool check = values.size() >= static_cast<size_t>(min_count) && values.size() >= next_check;
+    if (check || reason != "running") {
+        // Fewer resamples for the stopping test than for the reported interval
+        last = bootstrap_median_ci(values, confidence, 1000);
+        next_check = values.size() + std::max<size_t>(1, values.size() / 10);
+        if (last.relative_width() <= target) {
+            reason = "converged";
+        }
+    }
+    return reason == "running";
+}
+
+bool RepetitionController::converged() const {
+    return reason == "converged";
+}
+
+std::string RepetitionController::stop_reason() const {
+    return reason;
+}
+
+MedianInterval RepetitionController::interval() const {
+    return bootstrap_median_ci(values, confidence);
+}
+
+const std::vector<double>& RepetitionController::samples() const {
+    return values;
+}
@@ -0,0 +1,62 @@
+// repetition_control.h
+#ifndef REPETITION_CONTROL_H
+#define REPETITION_CONTROL_H
+
+#include <string>
+#include <vector>
+
+// Confidence interval of a sample median
+struct MedianInterval {
+    double median;
+    double low;
+    double high;
+    long samples;
+
+    MedianInterval() : median(0.0), low(0.0), high(0.0), samples(0) {}
+
+    // (high - low) / median; 0 for fewer than two samples or a zero median
+    double relative_width() const;
+};
+
+// Percentile bootstrap of the median: resample with replacement, take each
+// resample's median and report the (1 - confidence) / 2 tails.
+MedianInterval bootstrap_median_ci(const std::vector<double>& samples, double confidence = 0.95,
+                                   int resamples = 2000, unsigned int seed = 12345);
+
+// Decides how many times to repeat a measurement: keep sampling until the
+// bootstrap CI of the median is narrower than target_relative_width, or
+// max_samples / time_budget_s is reached. min_samples are always taken.
+// The CI is recomputed only after the sample count grows by about 10%, so
+// the bootstrap cost stays small next to the measured work.
+class RepetitionController {
+public:
+    RepetitionController(double target_relative_width, int min_samples = 5, int max_samples = 1000,
+                         double time_budget_s = 10.0, double confidence = 0.95);
+
+    // Record one measurement; returns true while more samples are wanted
+    bool add(double value);
+
+    bool converged() const;
+
+    // "converged", "max_samples", "time_budget", or "running"
+    std::string stop_reason() const;
+
+    // Interval over all samples so far
+    MedianInterval interval() const;
+
+    const std::vector<double>& samples() const;
+
+private:
+    double target;
+    int min_count;
+    int max_count;
+    double budget_ns;
+    double confidence;
+    long long start_ns;
+    size_t next_check;
+    std::string reason;
+    MedianInterval last;
+    std::vector<double> values;
+};
+
+#endif // REPETITION_CONTROL_H
@@ -0,0 +1,18 @@
+# setup.py for SWIG kernel instrumentation
+from setuptools import setup, Extension
+
+instrument_module = Extension(
+    '_instrument_swig',
+    sources=['instrument_swig.i', 'perf_counters.cpp', 'rapl_energy.cpp', 'latency_histogram.cpp',
+             'repetition_control.cpp', 'allocation_tracker.cpp', 'trace_spans.cpp',
+             'cache_flush.cpp'],
+    swig_opts=['-c++'],
+    libraries=['dl'],
+    extra_compile_args=['-O3', '-std=c++11'],
+)
+
+setup(
+    name='instrument_swig',
+    ext_modules=[instrument_module],
+    py_modules=['instrument_swig'],
+)
@@ -0,0 +1,282 @@
+// trace_spans.cpp
+#include "trace_spans.h"
+#include "latency_histogram.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+static const unsigned long long RING_CAPACITY = 1 << 15;    // spans per thread (1 MiB)
+static const unsigned long long RING_MASK = RING_CAPACITY - 1;
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    long long start_ns;
+    long long end_ns;
+};
+
+// The thread that recorded a ring's spans from index `first` up to the next
+// owner's first
+struct RingOwner {
+    unsigned long long first;
+    long tid;
+    const char* thread_name;
+};
+
+// Written only by its owning thread; the exporter reads up to `head`.
+// Rings are never freed, so spans of finished threads can still be exported.
+// When a thread exits its ring is retired and a new thread takes it over,
+// spans included, while it is less than half full, so a kernel that starts
+// threads on every call does not add a ring per call.
+struct ThreadRing {
+    TraceEvent events[RING_CAPACITY];
+    std::atomic<unsigned long long> head;       // spans ever recorded
+    std::atomic<unsigned long long> cleared;    // head at the last trace_clear()
+    std::atomic<bool> retired;                  // owner exited, free to take over
+    std::vector<RingOwner> owners;              // guarded by owners_lock
+    ThreadRing* next;
+};
+
+std::atomic<bool> trace_span_enabled(false);
+static std::atomic<ThreadRing*> rings(NULL);
+static std::mutex owners_lock;
+static thread_local ThreadRing* local_ring = NULL;
+static thread_local bool ring_released = false;
+
+// Stable copies of names passed in from Python
+static const char* intern(const std::string& s) {
+    static std::mutex lock;
+    static std::set<std::string> names;
+    std::lock_guard<std::mutex> guard(lock);
+    return names.insert(s).first->c_str();
+}
+
+// First retained span index of a ring, given its current head
+static unsigned long long first_held(const ThreadRing* ring, unsigned long long head) {
+    unsigned long long first = ring->cleared.load();
+    if (head - first > RING_CAPACITY) {
+        first = head - RING_CAPACITY;
+    }
+    return first;
+}
+
+// Drops the owners none of whose spans are still held. Call under owners_lock.
+static void prune_owners(ThreadRing* ring) {
+    unsigned long long first = first_held(ring, ring->head.load(std::memory_order_acquire));
+    size_t gone = 0;
+    while (gone + 1 < ring->owners.size() && ring->owners[gone + 1].first <= first) {
+        gone++;
+    }
+    ring->owners.erase(ring->owners.begin(), ring->owners.begin() + gone);
+}
+
+// Retires the calling thread's ring when the thread exits
+struct RingLease {
+    ThreadRing* ring;
+
+    RingLease() : ring(NULL) {}
+    ~RingLease() {
+        local_ring = NULL;
+        ring_released = true;
+        ring->retired.store(true, std::memory_order_release);
+    }
+};
+
+static ThreadRing* thread_ring() {
+    if (local_ring == NULL) {
+        RingOwner owner;
+        owner.tid = syscall(SYS_gettid);
+        owner.thread_name = NULL;
+
+        // Take over a retired ring that still has room for at least half its
+        // capacity, so reuse does not overwrite spans a new ring would keep
+        ThreadRing* ring = rings.load();
+        for (; ring; ring = ring->next) {
+            bool retired = true;
+            if (ring->retired.load(std::memory_order_relaxed) &&
+                ring->retired.compare_exchange_strong(retired, false, std::memory_order_acquire)) {
+                unsigned long long head = ring->head.load(std::memory_order_relaxed);
+                if (head - first_held(ring, head) < RING_CAPACITY / 2) {
+                    break;
+                }
+                ring->retired.store(true, std::memory_order_release);
+            }
+        }
+        if (ring) {
+            std::lock_guard<std::mutex> guard(owners_lock);
+            owner.first = ring->head.load(std::memory_order_relaxed);
+            ring->owners.push_back(owner);
+            prune_owners(ring);
+        } else {
+            ring = new ThreadRing();
+            ring->head.store(0);
+            ring->cleared.store(0);
+            ring->retired.store(false);
+            owner.first = 0;
+            ring->owners.push_back(owner);
+            ring->next = rings.load();
+            while (!rings.compare_exchange_weak(ring->next, ring)) {
+            }
+        }
+        local_ring = ring;
+
+        // A span recorded by another thread_local destructor after the lease
+        // is gone gets a ring of its own that is never retired
+        if (!ring_released) {
+            static thread_local RingLease lease;
+            lease.ring = ring;
+        }
+    }
+    return local_ring;
+}
+
+void trace_enable(bool on) {
+    trace_span_enabled.store(on);
+}
+
+bool trace_enabled() {
+    return trace_span_enabled.load(std::memory_order_relaxed);
+}
+
+extern "C" void trace_span_record(const char* category, const char* name,
+                                  long long start_ns, long long end_ns) {
+    if (!trace_span_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    ThreadRing* ring = thread_ring();
+    unsigned long long h = ring->head.load(std::memory_order_relaxed);
+    TraceEvent& ev = ring->events[h & RING_MASK];
+    ev.category = category;
+    ev.name = name;
+    ev.start_ns = start_ns;
+    ev.end_ns = end_ns;
+    ring->head.store(h + 1, std::memory_order_release);
+}
+
+void trace_record(const std::string& category, const std::string& name,
+                  long long start_ns, long long end_ns) {
+    if (trace_enabled()) {
+        trace_span_record(intern(category), intern(name), start_ns, end_ns);
+    }
+}
+
+void trace_thread_name(const std::string& name) {
+    ThreadRing* ring = thread_ring();
+    const char* interned = intern(name);
+    std::lock_guard<std::mutex> guard(owners_lock);
+    ring->owners.back().thread_name = interned;
+}
+
+long long trace_event_count() {
+    long long count = 0;
+    for (ThreadRing* ring = rings.load(); ring; ring = ring->next) {
+        unsigned long long head = ring->head.load(std::memory_order_acquire);
+        count += head - first_held(ring, head);
+    }
+    return count;
+}
+
+long long trace_dropped_count() {
+    long long dropped = 0;
+    for (ThreadRing* ring = rings.load(); ring; ring = ring->next) {
+        unsigned long long head = ring->head.load(std::memory_order_acquire);
+        dropped += first_held(ring, head) - ring->cleared.load();
+    }
+    return dropped;
+}
+
+void trace_clear() {
+    std::lock_guard<std::mutex> guard(owners_lock);
+    for (ThreadRing* ring = rings.load(); ring; ring = ring->next) {
+        ring->cleared.store(ring->head.load(std::memory_order_acquire));
+        prune_owners(ring);
+    }
+}
+
+static void write_escaped(FILE* out, const char* s) {
+    for (; *s; s++) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') {
+            std::fprintf(out, "\\%c", c);
+        } else if (c < 0x20) {
+            std::fprintf(out, "\\u%04x", c);
+        } else {
+            std::fputc(c, out);
+        }
+    }
+}
+
+bool trace_write_json(const std::string& path) {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+
+    // Timestamps are written relative to the earliest span, in microseconds
+    long long origin = -1;
+    for (ThreadRing* ring = rings.load(); ring; ring = ring->next) {
+        unsigned long long head = ring->head.load(std::memory_order_acquire);
+        for (unsigned long long i = first_held(ring, head); i < head; i++) {
+            long long start = ring->events[i & RING_MASK].start_ns;
+            if (origin < 0 || start < origin) {
+                origin = start;
+            }
+        }
+    }
+
+    long pid = getpid();
+    bool first = true;
+    std::fprintf(out, "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_spans\": %lld},\n"
+                 "\"traceEvents\": [", trace_dropped_count());
+    for (ThreadRing* ring = rings.load(); ring; ring = ring->next) {
+        std::vector<RingOwner> owners;
+        {
+            std::lock_guard<std::mutex> guard(owners_lock);
+            owners = ring->owners;
+        }
+        for (size_t k = 0; k < owners.size(); k++) {
+            std::fprintf(out, "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %ld, \"tid\": %ld, "
+                         "\"args\": {\"name\": \"", first ? "" : ",", pid, owners[k].tid);
+            if (owners[k].thread_name) {
+                write_escaped(out, owners[k].thread_name);
+            } else {
+                std::fprintf(out, "thread %ld", owners[k].tid);
+            }
+            std::fprintf(out, "\"}}");
+            first = false;
+        }
+
+        unsigned long long head = ring->head.load(std::memory_order_acquire);
+        size_t k = 0;
+        for (unsigned long long i = first_held(ring, head); i < head; i++) {
+            while (k + 1 < owners.size() && owners[k + 1].first <= i) {
+                k++;
+            }
+            const TraceEvent& ev = ring->events[i & RING_MASK];
+            std::fprintf(out, ",\n{\"name\": \"");
+            write_escaped(out, ev.name);
+            std::fprintf(out, "\", \"cat\": \"");
+            write_escaped(out, ev.category);
+            std::fprintf(out, "\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %ld, \"tid\": %ld}",
+                         (ev.start_ns - origin) / 1e3, (ev.end_ns - ev.start_ns) / 1e3, pid, owners[k].tid);
+        }
+    }
+    std::fprintf(out, "\n]}\n");
+
+    bool ok = !std::ferror(out);
+    return std::fclose(out) == 0 && ok;
+}
+
+TraceSpan::TraceSpan(const char* category, const char* name)
+    : category(category), name(name), start_ns(trace_enabled() ? now_ns() : -1) {}
+
+TraceSpan::~TraceSpan() {
+    if (start_ns >= 0) {
+        trace_span_record(category, name, start_ns, now_ns());
+    }
+}
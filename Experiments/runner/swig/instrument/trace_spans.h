@@ -0,0 +1,66 @@
+// trace_spans.h
+#ifndef TRACE_SPANS_H
+#define TRACE_SPANS_H
+
+#include <string>
+
+// Scoped timeline spans, exported as Chrome trace-event JSON (open in
+// chrome://tracing or ui.perfetto.dev). Every thread records into its own
+// fixed-size ring buffer with no locks; when a ring is full the oldest
+// spans are overwritten and counted as dropped. The ring of a thread that
+// has exited is taken over by a new thread, keeping its spans, while it is
+// less than half full, so memory grows with the threads alive at once and
+// the spans held rather than with every thread ever started. Recording is
+// off until trace_enable(true).
+
+void trace_enable(bool on);
+bool trace_enabled();
+
+// Records a finished span on the calling thread, copying name and category
+// once per distinct string (for spans named from Python)
+void trace_record(const std::string& category, const std::string& name,
+                  long long start_ns, long long end_ns);
+
+// Names the calling thread in the exported trace
+void trace_thread_name(const std::string& name);
+
+long long trace_event_count();      // spans currently held in the rings
+long long trace_dropped_count();    // spans overwritten because a ring was full
+
+// Empties every ring. Call only while no other thread is recording.
+void trace_clear();
+
+// Writes the buffered spans of all threads. Call while the traced code is
+// idle; a span recorded during the export may be missed.
+bool trace_write_json(const std::string& path);
+
+#ifndef SWIG
+#include <atomic>
+
+// Records a finished span on the calling thread. category and name are
+// stored as pointers and must outlive the trace (string literals). The
+// kernels reach this through kernel_trace.h.
+extern "C" void trace_span_record(const char* category, const char* name,
+                                  long long start_ns, long long end_ns);
+
+// What trace_enabled() reads; kernel_trace.h looks it up next to
+// trace_span_record so a disabled span skips the clock reads
+extern "C" std::atomic<bool> trace_span_enabled;
+
+// Span covering the enclosing scope
+class TraceSpan {
+public:
+    TraceSpan(const char* category, const char* name);
+    ~TraceSpan();
+
+private:
+    TraceSpan(const TraceSpan&);
+    TraceSpan& operator=(const TraceSpan&);
+
+    const char* category;
+    const char* name;
+    long long start_ns;     // -1 when tracing was off at construction
+};
+#endif
+
+#endif // TRACE_SPANS_H
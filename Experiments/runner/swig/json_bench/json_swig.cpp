@@ -1,9 +1,10 @@
 // json_swig.cpp
 #include "json_swig.h"
+#include "batch_dispatch.h"
 #include <cstdlib>
 #include <ctime>
 
-std::string generate_random_string(int length) {
+static void append_random_chars(int length, std::string& out) {
     static bool seeded = false;
     if (!seeded) {
         std::srand(std::time(nullptr));
@@ -13,12 +14,28 @@ std::string generate_random_string(int length) {
     const char* characters = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
     int num_chars = 62;
     
-    std::string result;
-    result.reserve(length);
-    
     for (int i = 0; i < length; i++) {
-        result += characters[std::rand() % num_chars];
+        out += characters[std::rand() % num_chars];
     }
-    
+}
+
+std::string generate_random_string(int length) {
+    std::string result;
+    result.reserve(length);
+    append_random_chars(length, result);
     return result;
-}
\ No newline at end of file
+}
+
+std::string generate_random_strings(const std::vector<int>& lengths) {
+    size_t total = 0;
+    for (size_t i = 0; i < lengths.size(); i++) {
+        total += lengths[i] > 0 ? lengths[i] : 0;
+    }
+
+    std::string packed;
+    packed.reserve(total);
+    dispatch_batch_packed(lengths, 1, packed, [](const int* length, std::string& out) {
+        append_random_chars(*length, out);
+    });
+    return packed;
+}
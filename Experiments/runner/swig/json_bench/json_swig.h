@@ -3,12 +3,18 @@
 #define JSON_SWIG_H
 
 #include <string>
+#include <vector>
 
 // Generate a random alphanumeric string
 std::string generate_random_string(int length);
 
+// Batched generate_random_string(): one string per entry of lengths, made
+// in one call and returned concatenated. String i starts at the sum of the
+// lengths before it.
+std::string generate_random_strings(const std::vector<int>& lengths);
+
 // Note: Actual JSON encoding/decoding should still use Python's json module
 // as it's already highly optimized in C. This SWIG module only provides
 // helper functions for data generation.
 
-#endif // JSON_SWIG_H
\ No newline at end of file
+#endif // JSON_SWIG_H
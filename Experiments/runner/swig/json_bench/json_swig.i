@@ -6,5 +6,10 @@
 %}
 
 %include "std_string.i"
+%include "std_vector.i"
+
+namespace std {
+    %template(IntVector) vector<int>;
+}
 
 %include "json_swig.h"
\ No newline at end of file
@@ -2,8 +2,16 @@ import time
 import json
 import random
 import string
+import os
+import sys
 import json_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency, use_batched_calls
+
+metrics = KernelMetrics()
+
 # --- JSON Data Generation ---
 
 def generate_random_string(length):
@@ -12,19 +20,45 @@ def generate_random_string(length):
     return ''.join(random.choice(characters) for i in range(length))
 
 
+def _batched_strings(lengths):
+    """Random strings of the given lengths from one json_swig call, handed out in order."""
+    packed = json_swig.generate_random_strings(lengths)
+    pos = 0
+
+    def next_string(length):
+        nonlocal pos
+        s = packed[pos:pos + length]
+        pos += length
+        return s
+    return next_string
+
+
 def create_complex_data(num_records, use_swig=False):
     """
     Creates a complex, nested Python dictionary/list structure for JSON testing.
     
     Args:
         num_records: Number of records to generate
-        use_swig: If True, use SWIG for string generation (faster)
+        use_swig: If True, use SWIG for string generation (faster). With
+            SWIG_BATCH_CALLS=1 all strings come from one batched call instead
+            of one SWIG call each.
     
     The structure simulates records with various data types (string, int, float, list, dict).
     """
     data_list = []
     
-    gen_func = json_swig.generate_random_string if use_swig else generate_random_string
+    if use_swig and use_batched_calls():
+        # Drawn up front so the batched call knows every string length. This
+        # consumes the random stream in a different order than the per-call
+        # path, so the records differ from those of the default run
+        tag_counts = [random.randint(2, 5) for _ in range(num_records)]
+        lengths = []
+        for n_tags in tag_counts:
+            lengths += [32] + [5] * n_tags + [10]  # uuid, tags, city in record order
+        gen_func = _batched_strings(lengths)
+    else:
+        tag_counts = None
+        gen_func = json_swig.generate_random_string if use_swig else generate_random_string
     
     for i in range(num_records):
         record = {
@@ -32,7 +66,7 @@ def create_complex_data(num_records, use_swig=False):
             "uuid": gen_func(32),
             "isActive": random.choice([True, False]),
             "balance": round(random.uniform(10.0, 50000.0), 2),
-            "tags": [gen_func(5) for _ in range(random.randint(2, 5))],
+            "tags": [gen_func(5) for _ in range(tag_counts[i] if tag_counts else random.randint(2, 5))],
             "profile": {
                 "age": random.randint(18, 65),
                 "city": gen_func(10),
@@ -50,7 +84,19 @@ def create_complex_data(num_records, use_swig=False):
 
 # --- JSON Benchmarking Function ---
 
-def benchmark_json_io(num_records, num_runs=5, use_swig=False):
+def prepare_json_io(num_records, num_runs=5, use_swig=False):
+    """Generates the record list for benchmark_json_io() and warms up json."""
+    # 1. Generate the initial complex Python object once
+    with metrics.span(f"generate records={num_records}"):
+        py_data = create_complex_data(num_records, use_swig=use_swig)
+    
+    # Warm-up run
+    warmup_json = json.dumps(py_data)
+    json.loads(warmup_json)
+    return py_data
+
+
+def benchmark_json_io(num_records, num_runs=5, use_swig=False, inputs=None):
     """
     Benchmarks JSON encoding (dumps) and decoding (loads) performance.
     
@@ -58,36 +104,39 @@ def benchmark_json_io(num_records, num_runs=5, use_swig=False):
         num_records (int): The number of records to generate for the complex data structure.
         num_runs (int): The number of times to run the full IO cycle for averaging.
         use_swig (bool): Use SWIG for data generation (faster)
+        inputs: Result of prepare_json_io(), generated here if None.
         
     Returns:
         dict: Results including average time for dumps, loads, and total.
     """
-    # 1. Generate the initial complex Python object once
-    py_data = create_complex_data(num_records, use_swig=use_swig)
-    
-    # Warm-up run
-    warmup_json = json.dumps(py_data)
-    json.loads(warmup_json)
+    py_data = inputs if inputs is not None else prepare_json_io(num_records, num_runs, use_swig)
     
     total_dump_time = 0
     total_load_time = 0
+    label_dump = f"dumps records={num_records}"
+    label_load = f"loads records={num_records}"
     
-    for _ in range(num_runs):
+    # The dumps latency decides the run count when it is adaptive
+    runs = 0
+    for _ in metrics.repetitions(label_dump, num_runs):
         
         # --- Encode (dumps) ---
-        start_dump = time.perf_counter()
-        json_string = json.dumps(py_data)
-        end_dump = time.perf_counter()
+        with metrics.measure(label_dump):
+            start_dump = time.perf_counter()
+            json_string = json.dumps(py_data)
+            end_dump = time.perf_counter()
         total_dump_time += (end_dump - start_dump)
         
         # --- Decode (loads) ---
-        start_load = time.perf_counter()
-        json.loads(json_string)
-        end_load = time.perf_counter()
+        with metrics.measure(label_load):
+            start_load = time.perf_counter()
+            json.loads(json_string)
+            end_load = time.perf_counter()
         total_load_time += (end_load - start_load)
+        runs += 1
 
-    avg_dump_time_ms = (total_dump_time / num_runs) * 1000
-    avg_load_time_ms = (total_load_time / num_runs) * 1000
+    avg_dump_time_ms = (total_dump_time / runs) * 1000
+    avg_load_time_ms = (total_load_time / runs) * 1000
     avg_total_time_ms = avg_dump_time_ms + avg_load_time_ms
     
     # Get size information from one run
@@ -99,13 +148,25 @@ def benchmark_json_io(num_records, num_runs=5, use_swig=False):
         "algorithm": f"JSON Encode/Decode {method_str}",
         "num_records": num_records,
         "json_size_kb": json_size_kb,
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_dump_ms": avg_dump_time_ms,
         "avg_load_ms": avg_load_time_ms,
         "avg_total_ms": avg_total_time_ms,
+        "dump_latency": metrics.latency(label_dump),
+        "load_latency": metrics.latency(label_load),
     }
 
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_json_io, benchmark_json_io, (5000, 10, True)),
+    (prepare_json_io, benchmark_json_io, (20000, 5, True)),
+]
+
+
 # --- Execution ---
 
 if __name__ == "__main__":
@@ -116,8 +177,7 @@ if __name__ == "__main__":
     print("-" * 70)
     
     # --- JSON Benchmark Test 1: Moderate Data Size ---
-    num_records_1 = 5000
-    runs1 = 10
+    num_records_1, runs1, _ = WORKLOADS[0][2]
     
     print(f"\n--- Test 1: {num_records_1:,} Complex Records (SWIG-assisted) ---")
     results1 = benchmark_json_io(num_records_1, runs1, use_swig=True)
@@ -129,12 +189,13 @@ if __name__ == "__main__":
     print(f"  Avg. Encode (dumps) Time: {results1['avg_dump_ms']:.4f} ms")
     print(f"  Avg. Decode (loads) Time: {results1['avg_load_ms']:.4f} ms")
     print(f"  Avg. Total I/O Time:      {results1['avg_total_ms']:.4f} ms")
+    print(f"  Encode latency: {format_latency(results1['dump_latency'])}")
+    print(f"  Decode latency: {format_latency(results1['load_latency'])}")
     
     print("-" * 70)
     
     # --- JSON Benchmark Test 2: Larger Data Size ---
-    num_records_2 = 20000
-    runs2 = 5
+    num_records_2, runs2, _ = WORKLOADS[1][2]
     
     print(f"\n--- Test 2: {num_records_2:,} Complex Records (SWIG-assisted) ---")
     results2 = benchmark_json_io(num_records_2, runs2, use_swig=True)
@@ -146,5 +207,9 @@ if __name__ == "__main__":
     print(f"  Avg. Encode (dumps) Time: {results2['avg_dump_ms']:.4f} ms")
     print(f"  Avg. Decode (loads) Time: {results2['avg_load_ms']:.4f} ms")
     print(f"  Avg. Total I/O Time:      {results2['avg_total_ms']:.4f} ms")
+    print(f"  Encode latency: {format_latency(results2['dump_latency'])}")
+    print(f"  Decode latency: {format_latency(results2['load_latency'])}")
+    
+    print("-" * 70)
     
-    print("-" * 70)
\ No newline at end of file
+    metrics.save()
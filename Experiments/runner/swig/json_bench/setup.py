@@ -5,6 +5,7 @@ json_module = Extension(
     '_json_swig',
     sources=['json_swig.i', 'json_swig.cpp'],
     swig_opts=['-c++'],
+    include_dirs=['../batch'],  # batch_dispatch.h
     extra_compile_args=['-O3', '-std=c++11'],
 )
 
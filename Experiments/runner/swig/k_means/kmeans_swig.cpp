@@ -1,14 +1,15 @@
 // kmeans_swig.cpp
 #include "kmeans_swig.h"
+#include "kernel_trace.h"
+#include "batch_dispatch.h"
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <limits>
 #include <algorithm>
 
-double euclidean_distance(const Point& p1, const Point& p2) {
+static double distance(const double* p1, const double* p2, size_t D) {
     double distance_sq = 0.0;
-    size_t D = p1.size();
     
     for (size_t i = 0; i < D; i++) {
         double diff = p1[i] - p2[i];
@@ -18,6 +19,16 @@ double euclidean_distance(const Point& p1, const Point& p2) {
     return std::sqrt(distance_sq);
 }
 
+double euclidean_distance(const Point& p1, const Point& p2) {
+    return distance(p1.data(), p2.data(), p1.size());
+}
+
+std::vector<double> euclidean_distances(const std::vector<double>& pairs, int dims) {
+    KERNEL_TRACE_SPAN("euclidean_distances");
+    size_t D = dims > 0 ? dims : 0;
+    return dispatch_batch(pairs, 2 * D, [D](const double* p) { return distance(p, p + D, D); });
+}
+
 DataSet initialize_data(int N, int D, double max_val) {
     DataSet data;
     data.reserve(N);
@@ -72,6 +83,7 @@ DataSet initialize_centroids(const DataSet& data, int K) {
 }
 
 DataSet kmeans_iteration(const DataSet& data, const DataSet& centroids) {
+    KERNEL_TRACE_SPAN("kmeans_iteration");
     int N = data.size();
     int K = centroids.size();
     
@@ -129,4 +141,40 @@ DataSet kmeans_iteration(const DataSet& data, const DataSet& centroids) {
     }
     
     return new_centroids;
-}
\ No newline at end of file
+}
+
+PointSetHandle::PointSetHandle() {}
+
+PointSetHandle::PointSetHandle(int N, int D, double max_val) : data(initialize_data(N, D, max_val)) {}
+
+PointSetHandle::PointSetHandle(const DataSet& points) : data(points) {}
+
+int PointSetHandle::size() const {
+    return data.size();
+}
+
+int PointSetHandle::dims() const {
+    return data.empty() ? 0 : data[0].size();
+}
+
+PointSetHandle PointSetHandle::sample(int K) const {
+    PointSetHandle centroids;
+    centroids.data = initialize_centroids(data, K);
+    return centroids;
+}
+
+DataSet PointSetHandle::to_list() const {
+    return data;
+}
+
+const DataSet& PointSetHandle::points() const {
+    return data;
+}
+
+DataSet& PointSetHandle::points() {
+    return data;
+}
+
+void kmeans_iteration_into(const PointSetHandle& data, const PointSetHandle& centroids, PointSetHandle& out) {
+    out.points() = kmeans_iteration(data.points(), centroids.points());
+}
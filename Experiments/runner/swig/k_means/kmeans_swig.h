@@ -21,4 +21,38 @@ DataSet kmeans_iteration(const DataSet& data, const DataSet& centroids);
 // Helper function to calculate Euclidean distance
 double euclidean_distance(const Point& p1, const Point& p2);
 
+// Batched euclidean_distance(): pairs holds the two dims-dimensional points
+// of each call back to back (2 * dims values per call); returns one distance
+// per call
+std::vector<double> euclidean_distances(const std::vector<double>& pairs, int dims);
+
+// Point set kept in C++ across calls, so an iteration converts neither the
+// data nor the centroids; to_list() exports the points
+class PointSetHandle {
+public:
+    PointSetHandle();
+    // N random D-dimensional points, as initialize_data()
+    PointSetHandle(int N, int D, double max_val = 100.0);
+    explicit PointSetHandle(const DataSet& points);
+
+    int size() const;
+    int dims() const;
+
+    // K random points of this set, as initialize_centroids()
+    PointSetHandle sample(int K) const;
+
+    DataSet to_list() const;
+
+#ifndef SWIG
+    const DataSet& points() const;
+    DataSet& points();
+#endif
+
+private:
+    DataSet data;
+};
+
+// kmeans_iteration() on handles; the new centroids replace out's contents
+void kmeans_iteration_into(const PointSetHandle& data, const PointSetHandle& centroids, PointSetHandle& out);
+
 #endif // KMEANS_SWIG_H
\ No newline at end of file
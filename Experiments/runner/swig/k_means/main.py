@@ -1,8 +1,16 @@
 import time
 import random
 import math
+import os
+import sys
 import kmeans_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency, use_handles
+
+metrics = KernelMetrics()
+
 # --- K-means Implementations (Python version for reference) ---
 
 def _euclidean_distance(p1, p2):
@@ -84,7 +92,37 @@ def kmeans_iteration(data, centroids):
 
 # --- K-means Benchmarking Function (SWIG version) ---
 
-def benchmark_kmeans(N, D, K, num_runs=5):
+def prepare_kmeans(N, D, K, num_runs=5):
+    """Generates the data set and starting centroids of each run and warms up the kernel."""
+    label = f"N={N} D={D} K={K}"
+    handles = use_handles()
+    
+    # Generate the initial data set (static for all runs)
+    with metrics.span(f"generate {label}"):
+        if handles:
+            initial_data = kmeans_swig.PointSetHandle(N, D)
+            initial_states = [(initial_data, initial_data.sample(K)) for _ in range(num_runs)]
+        else:
+            initial_data = kmeans_swig.initialize_data(N, D)
+    
+            # Generate unique starting centroids for each run
+            initial_states = [
+                (initial_data, kmeans_swig.initialize_centroids(initial_data, K))
+                for _ in range(num_runs)
+            ]
+    
+    # Warm-up run with smaller data
+    N_warmup = max(10, int(N * 0.1))
+    D_warmup = max(1, D)
+    K_warmup = max(1, K)
+    
+    warmup_data = kmeans_swig.initialize_data(N_warmup, D_warmup)
+    warmup_centroids = kmeans_swig.initialize_centroids(warmup_data, K_warmup)
+    kmeans_swig.kmeans_iteration(warmup_data, warmup_centroids)
+    return initial_states
+
+
+def benchmark_kmeans(N, D, K, num_runs=5, inputs=None):
     """
     Benchmarks the K-means iteration algorithm (SWIG version).
     
@@ -93,38 +131,33 @@ def benchmark_kmeans(N, D, K, num_runs=5):
         D (int): Dimensionality of data points.
         K (int): Number of clusters.
         num_runs (int): The number of times to run the iteration for averaging.
+        inputs: Result of prepare_kmeans(N, D, K, num_runs), generated here if None.
         
     Returns:
         dict: Results including average time.
     """
     total_time = 0
-    
-    # Generate the initial data set (static for all runs)
-    initial_data = kmeans_swig.initialize_data(N, D)
-    
-    # Generate unique starting centroids for each run
-    initial_states = [
-        (initial_data, kmeans_swig.initialize_centroids(initial_data, K))
-        for _ in range(num_runs)
-    ]
-    
-    # Warm-up run with smaller data
-    N_warmup = max(10, int(N * 0.1))
-    D_warmup = max(1, D)
-    K_warmup = max(1, K)
-    
-    warmup_data = kmeans_swig.initialize_data(N_warmup, D_warmup)
-    warmup_centroids = kmeans_swig.initialize_centroids(warmup_data, K_warmup)
-    kmeans_swig.kmeans_iteration(warmup_data, warmup_centroids)
-    
-    for data, centroids in initial_states:
-        start_time = time.perf_counter()
-        kmeans_swig.kmeans_iteration(data, centroids)
-        end_time = time.perf_counter()
+    label = f"N={N} D={D} K={K}"
+    handles = use_handles()
+    initial_states = inputs if inputs is not None else prepare_kmeans(N, D, K, num_runs)
+    if handles:
+        new_centroids = kmeans_swig.PointSetHandle()
+    
+    runs = 0
+    for run in metrics.repetitions(label, num_runs):
+        data, centroids = initial_states[run % len(initial_states)]
+        with metrics.measure(label):
+            start_time = time.perf_counter()
+            if handles:
+                kmeans_swig.kmeans_iteration_into(data, centroids, new_centroids)
+            else:
+                kmeans_swig.kmeans_iteration(data, centroids)
+            end_time = time.perf_counter()
         
         total_time += (end_time - start_time)
+        runs += 1
 
-    avg_time_ms = (total_time / num_runs) * 1000
+    avg_time_ms = (total_time / runs) * 1000
     
     return {
         "algorithm": "K-means Single Iteration (SWIG)",
@@ -132,11 +165,22 @@ def benchmark_kmeans(N, D, K, num_runs=5):
         "D": D,
         "K": K,
         "complexity": "O(N * K * D)",
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_time_ms": avg_time_ms,
+        "latency": metrics.latency(label),
     }
 
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_kmeans, benchmark_kmeans, (20000, 5, 10, 5)),
+    (prepare_kmeans, benchmark_kmeans, (5000, 100, 15, 5)),
+]
+
+
 # --- Execution ---
 
 if __name__ == "__main__":
@@ -146,8 +190,7 @@ if __name__ == "__main__":
     print("-" * 60)
     
     # --- K-means Benchmark Test 1: High N (data points), Low K (clusters) ---
-    N1, D1, K1 = 20000, 5, 10
-    runs1 = 5
+    N1, D1, K1, runs1 = WORKLOADS[0][2]
     
     print(f"\n--- Test 1: N={N1:,}, D={D1}, K={K1} ---")
     results1 = benchmark_kmeans(N1, D1, K1, runs1)
@@ -159,12 +202,12 @@ if __name__ == "__main__":
     print(f"Complexity: {results1['complexity']}")
     print(f"Total Runs: {results1['num_runs']}")
     print(f"Average Execution Time: {results1['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results1['latency'])}")
     
     print("-" * 60)
     
     # --- K-means Benchmark Test 2: High D (dimensions), Moderate N ---
-    N2, D2, K2 = 5000, 100, 15
-    runs2 = 5
+    N2, D2, K2, runs2 = WORKLOADS[1][2]
     
     print(f"\n--- Test 2: N={N2:,}, D={D2}, K={K2} (Focus on dimensionality) ---")
     results2 = benchmark_kmeans(N2, D2, K2, runs2)
@@ -175,4 +218,7 @@ if __name__ == "__main__":
     print(f"Clusters (K): {results2['K']}")
     print(f"Complexity: {results2['complexity']}")
     print(f"Total Runs: {results2['num_runs']}")
-    print(f"Average Execution Time: {results2['avg_time_ms']:.4f} ms")
\ No newline at end of file
+    print(f"Average Execution Time: {results2['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results2['latency'])}")
+    
+    metrics.save()
@@ -5,6 +5,8 @@ kmeans_module = Extension(
     '_kmeans_swig',
     sources=['kmeans_swig.i', 'kmeans_swig.cpp'],
     swig_opts=['-c++'],
+    include_dirs=['../instrument', '../batch'],  # kernel_trace.h, batch_dispatch.h
+    libraries=['dl'],
     extra_compile_args=['-O3', '-std=c++11', '-ffast-math'],
 )
 
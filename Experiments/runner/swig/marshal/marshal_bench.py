@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""
+SWIG Marshalling Microbenchmarks
+--------------------------------
+Measures what the std_vector.i / std_map.i conversions in the generated
+*_swig_wrap.cpp files cost, apart from any kernel work. Build the module
+first (python setup.py build_ext --inplace), then:
+
+    python marshal_bench.py [--types DoubleVector,Graph,...] [--sizes 10,100,...]
+                            [--min-time 0.05] [--repetitions 5] [--json FILE]
+
+For every type and size, the identity kernels of marshal_swig are timed in
+each direction:
+
+    to_cpp      x_in(value)        Python object -> C++ container
+    to_python   x_out()            C++ container -> Python object
+    round_trip  x_identity(value)  both
+
+Each time is the best of --repetitions samples. It has the cost of an empty
+call (marshal_noop, timed through the same lambda) subtracted, and for to_python and round_trip also the
+C++ copy made by returning by value. The result is divided by the element
+count: values for DoubleVector and ComplexVector, doubles for Matrix2D,
+adjacency entries for Graph, strings for StringVector and bodies for
+BodiesVector. Multiplying by the input size of a benchmark gives the share
+of its SWIG call that is conversion rather than kernel.
+"""
+import argparse
+import json
+import math
+import random
+import sys
+import timeit
+
+import marshal_swig
+
+GRAPH_DEGREE = 8
+STRING_LENGTH = 16
+
+
+# ------------------ Inputs ------------------
+
+def make_double_vector(n):
+    return [random.random() for _ in range(n)], n
+
+
+def make_matrix2d(n):
+    rows = max(1, math.isqrt(n))
+    cols = max(1, n // rows)
+    return [[random.random() for _ in range(cols)] for _ in range(rows)], rows * cols
+
+
+def make_graph(n):
+    vertices = max(1, n // GRAPH_DEGREE)
+    graph = {v: [random.randrange(vertices) for _ in range(GRAPH_DEGREE)] for v in range(vertices)}
+    return graph, vertices * GRAPH_DEGREE
+
+
+def make_complex_vector(n):
+    return [complex(random.random(), random.random()) for _ in range(n)], n
+
+
+def make_string_vector(n):
+    letters = "abcdefghijklmnopqrstuvwxyz"
+    return ["".join(random.choice(letters) for _ in range(STRING_LENGTH)) for _ in range(n)], n
+
+
+def make_bodies_vector(n):
+    bodies = [marshal_swig.Body(random.random(), random.random(), random.random(),
+                                random.random(), random.random()) for _ in range(n)]
+    return bodies, n
+
+
+# type name -> (function prefix in marshal_swig, input builder)
+TYPES = {
+    "DoubleVector": ("double_vector", make_double_vector),
+    "Matrix2D": ("matrix2d", make_matrix2d),
+    "Graph": ("graph", make_graph),
+    "ComplexVector": ("complex_vector", make_complex_vector),
+    "StringVector": ("string_vector", make_string_vector),
+    "BodiesVector": ("bodies_vector", make_bodies_vector),
+}
+
+
+# ------------------ Timing ------------------
+
+def best_call_ns(call, min_time, repetitions):
+    """Best per-call time in ns over repetitions samples of at least min_time seconds."""
+    timer = timeit.Timer(call)
+    number = 1
+    while True:
+        elapsed = timer.timeit(number)
+        if elapsed >= min_time:
+            break
+        number = number * 2 if elapsed <= 0 else max(number + 1, int(number * min_time / elapsed * 1.1))
+    samples = [elapsed] + timer.repeat(repeat=max(0, repetitions - 1), number=number)
+    return min(samples) / number * 1e9
+
+
+def measure(type_name, n, noop_ns, args):
+    prefix, build = TYPES[type_name]
+    to_cpp = getattr(marshal_swig, prefix + "_in")
+    hold = getattr(marshal_swig, prefix + "_hold")
+    to_python = getattr(marshal_swig, prefix + "_out")
+    identity = getattr(marshal_swig, prefix + "_identity")
+    copy_ns = getattr(marshal_swig, prefix + "_copy_ns")
+
+    value, elements = build(n)
+    hold(value)
+    copy = copy_ns(max(1, 1000000 // max(1, elements)))
+
+    in_ns = best_call_ns(lambda: to_cpp(value), args.min_time, args.repetitions)
+    out_ns = best_call_ns(lambda: to_python(), args.min_time, args.repetitions)
+    round_ns = best_call_ns(lambda: identity(value), args.min_time, args.repetitions)
+
+    return {
+        "type": type_name,
+        "size": n,
+        "elements": elements,
+        "call_ns": noop_ns,
+        "copy_ns": copy,
+        "to_cpp_ns_per_element": max(0.0, in_ns - noop_ns) / elements,
+        "to_python_ns_per_element": max(0.0, out_ns - noop_ns - copy) / elements,
+        "round_trip_ns_per_element": max(0.0, round_ns - noop_ns - copy) / elements,
+    }
+
+
+# ------------------ Main ------------------
+
+def main():
+    parser = argparse.ArgumentParser(description="Time SWIG argument and result conversion per element.")
+    parser.add_argument("--types", type=str, default=",".join(TYPES),
+                        help="Comma-separated container types (default: all)")
+    parser.add_argument("--sizes", type=str, default="10,100,1000,10000,100000",
+                        help="Element counts (N,M,...)")
+    parser.add_argument("--min-time", type=float, default=0.05, help="Minimum duration of one sample")
+    parser.add_argument("--repetitions", type=int, default=5, help="Samples per measurement (best is kept)")
+    parser.add_argument("--json", type=str, default="", help="Also write the results to this file ('-' for stdout)")
+    args = parser.parse_args()
+
+    types = [t for t in args.types.split(",") if t]
+    unknown = [t for t in types if t not in TYPES]
+    if unknown:
+        parser.error("unknown type(s) %s; choose from %s" % (", ".join(unknown), ", ".join(TYPES)))
+    sizes = [int(s) for s in args.sizes.split(",") if s]
+
+    random.seed(12345)
+    noop = marshal_swig.marshal_noop
+    noop_ns = best_call_ns(lambda: noop(), args.min_time, args.repetitions)
+    out = sys.stderr if args.json == "-" else sys.stdout
+    print("empty call: %.1f ns" % noop_ns, file=out)
+    print("%-14s %9s %9s  %16s %16s %16s" % ("type", "size", "elements", "to_cpp ns/el",
+                                             "to_python ns/el", "round_trip ns/el"), file=out)
+
+    results = []
+    for type_name in types:
+        for n in sizes:
+            row = measure(type_name, n, noop_ns, args)
+            results.append(row)
+            print("%-14s %9d %9d  %16.2f %16.2f %16.2f" % (
+                type_name, n, row["elements"], row["to_cpp_ns_per_element"],
+                row["to_python_ns_per_element"], row["round_trip_ns_per_element"]), file=out)
+
+    if args.json:
+        text = json.dumps({"call_ns": noop_ns, "results": results}, indent=2)
+        if args.json == "-":
+            print(text)
+        else:
+            with open(args.json, "w") as f:
+                f.write(text + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
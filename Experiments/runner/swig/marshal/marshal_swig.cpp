@@ -0,0 +1,149 @@
+// marshal_swig.cpp
+#include "marshal_swig.h"
+
+#include <chrono>
+
+// Values returned by the *_out() calls
+static DoubleVector held_double_vector;
+static Matrix2D held_matrix2d;
+static Graph held_graph;
+static ComplexVector held_complex_vector;
+static StringVector held_string_vector;
+static BodiesVector held_bodies_vector;
+
+template <class T>
+static double copy_ns(const T& value, int repetitions) {
+    if (repetitions < 1) {
+        repetitions = 1;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        T copy(value);
+        asm volatile("" : : "r"(&copy) : "memory");
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / repetitions;
+}
+
+void marshal_noop() {
+}
+
+long double_vector_in(const DoubleVector& v) {
+    return static_cast<long>(v.size());
+}
+
+void double_vector_hold(const DoubleVector& v) {
+    held_double_vector = v;
+}
+
+DoubleVector double_vector_out() {
+    return held_double_vector;
+}
+
+DoubleVector double_vector_identity(const DoubleVector& v) {
+    return v;
+}
+
+double double_vector_copy_ns(int repetitions) {
+    return copy_ns(held_double_vector, repetitions);
+}
+
+long matrix2d_in(const Matrix2D& m) {
+    return static_cast<long>(m.size());
+}
+
+void matrix2d_hold(const Matrix2D& m) {
+    held_matrix2d = m;
+}
+
+Matrix2D matrix2d_out() {
+    return held_matrix2d;
+}
+
+Matrix2D matrix2d_identity(const Matrix2D& m) {
+    return m;
+}
+
+double matrix2d_copy_ns(int repetitions) {
+    return copy_ns(held_matrix2d, repetitions);
+}
+
+long graph_in(const Graph& g) {
+    return static_cast<long>(g.size());
+}
+
+void graph_hold(const Graph& g) {
+    held_graph = g;
+}
+
+Graph graph_out() {
+    return held_graph;
+}
+
+Graph graph_identity(const Graph& g) {
+    return g;
+}
+
+double graph_copy_ns(int repetitions) {
+    return copy_ns(held_graph, repetitions);
+}
+
+long complex_vector_in(const ComplexVector& v) {
+    return static_cast<long>(v.size());
+}
+
+void complex_vector_hold(const ComplexVector& v) {
+    held_complex_vector = v;
+}
+
+ComplexVector complex_vector_out() {
+    return held_complex_vector;
+}
+
+ComplexVector complex_vector_identity(const ComplexVector& v) {
+    return v;
+}
+
+double complex_vector_copy_ns(int repetitions) {
+    return copy_ns(held_complex_vector, repetitions);
+}
+
+long string_vector_in(const StringVector& v) {
+    return static_cast<long>(v.size());
+}
+
+void string_vector_hold(const StringVector& v) {
+    held_string_vector = v;
+}
+
+StringVector string_vector_out() {
+    return held_string_vector;
+}
+
+StringVector string_vector_identity(const StringVector& v) {
+    return v;
+}
+
+double string_vector_copy_ns(int repetitions) {
+    return copy_ns(held_string_vector, repetitions);
+}
+
+long bodies_vector_in(const BodiesVector& v) {
+    return static_cast<long>(v.size());
+}
+
+void bodies_vector_hold(const BodiesVector& v) {
+    held_bodies_vector = v;
+}
+
+BodiesVector bodies_vector_out() {
+    return held_bodies_vector;
+}
+
+BodiesVector bodies_vector_identity(const BodiesVector& v) {
+    return v;
+}
+
+double bodies_vector_copy_ns(int repetitions) {
+    return copy_ns(held_bodies_vector, repetitions);
+}
@@ -0,0 +1,84 @@
+// marshal_swig.h
+#ifndef MARSHAL_SWIG_H
+#define MARSHAL_SWIG_H
+
+#include <complex>
+#include <map>
+#include <string>
+#include <vector>
+
+// Identity kernels for the container types the benchmark modules convert
+// with std_vector.i / std_map.i. They do no work of their own, so the time
+// of a call is the SWIG call itself plus the argument and result conversion.
+// marshal_bench.py times them and reports nanoseconds per element.
+//
+// For every type X there are four calls:
+//     x_in(value)        Python -> C++ only; returns the container's size()
+//     x_hold(value)      stores a copy for x_out()
+//     x_out()            C++ -> Python only; returns the stored value
+//     x_identity(value)  both directions
+// and x_copy_ns(repetitions), the time to copy the stored value in C++,
+// which the benchmark subtracts from x_out() and x_identity() since both
+// return by value.
+
+typedef std::vector<double> DoubleVector;
+typedef std::vector<std::vector<double> > Matrix2D;
+typedef std::map<int, std::vector<int> > Graph;
+typedef std::vector<std::complex<double> > ComplexVector;
+typedef std::vector<std::string> StringVector;
+
+// Same layout as Body in nbody_swig.h
+struct Body {
+    double x;
+    double y;
+    double vx;
+    double vy;
+    double m;
+
+    Body() : x(0), y(0), vx(0), vy(0), m(0) {}
+    Body(double x_, double y_, double vx_, double vy_, double m_)
+        : x(x_), y(y_), vx(vx_), vy(vy_), m(m_) {}
+};
+
+typedef std::vector<Body> BodiesVector;
+
+// Fixed cost of one call with no arguments and no result
+void marshal_noop();
+
+long double_vector_in(const DoubleVector& v);
+void double_vector_hold(const DoubleVector& v);
+DoubleVector double_vector_out();
+DoubleVector double_vector_identity(const DoubleVector& v);
+double double_vector_copy_ns(int repetitions);
+
+long matrix2d_in(const Matrix2D& m);
+void matrix2d_hold(const Matrix2D& m);
+Matrix2D matrix2d_out();
+Matrix2D matrix2d_identity(const Matrix2D& m);
+double matrix2d_copy_ns(int repetitions);
+
+long graph_in(const Graph& g);
+void graph_hold(const Graph& g);
+Graph graph_out();
+Graph graph_identity(const Graph& g);
+double graph_copy_ns(int repetitions);
+
+long complex_vector_in(const ComplexVector& v);
+void complex_vector_hold(const ComplexVector& v);
+ComplexVector complex_vector_out();
+ComplexVector complex_vector_identity(const ComplexVector& v);
+double complex_vector_copy_ns(int repetitions);
+
+long string_vector_in(const StringVector& v);
+void string_vector_hold(const StringVector& v);
+StringVector string_vector_out();
+StringVector string_vector_identity(const StringVector& v);
+double string_vector_copy_ns(int repetitions);
+
+long bodies_vector_in(const BodiesVector& v);
+void bodies_vector_hold(const BodiesVector& v);
+BodiesVector bodies_vector_out();
+BodiesVector bodies_vector_identity(const BodiesVector& v);
+double bodies_vector_copy_ns(int repetitions);
+
+#endif // MARSHAL_SWIG_H
@@ -0,0 +1,32 @@
+/* marshal_swig.i */
+%module marshal_swig
+
+%{
+#include "marshal_swig.h"
+%}
+
+%include "std_string.i"
+%include "std_vector.i"
+%include "std_map.i"
+%include "std_complex.i"
+
+// Same instantiations as the benchmark modules, so the generated conversions
+// are the ones their wrappers use
+namespace std {
+    %template(DoubleVector) vector<double>;
+    %template(Matrix2D) vector<vector<double>>;
+    %template(IntVector) vector<int>;
+    %template(Graph) map<int, vector<int>>;
+    %template(Complex) complex<double>;
+    %template(ComplexVector) vector<complex<double>>;
+    %template(StringVector) vector<string>;
+}
+
+// Instantiated before the header, so the functions taking or returning
+// BodiesVector get its sequence typemaps rather than an opaque pointer
+struct Body;
+namespace std {
+    %template(BodiesVector) vector<Body>;
+}
+
+%include "marshal_swig.h"
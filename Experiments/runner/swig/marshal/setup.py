@@ -0,0 +1,15 @@
+# setup.py for the SWIG marshalling microbenchmarks
+from setuptools import setup, Extension
+
+marshal_module = Extension(
+    '_marshal_swig',
+    sources=['marshal_swig.i', 'marshal_swig.cpp'],
+    swig_opts=['-c++'],
+    extra_compile_args=['-O3', '-std=c++11'],
+)
+
+setup(
+    name='marshal_swig',
+    ext_modules=[marshal_module],
+    py_modules=['marshal_swig'],
+)
@@ -1,8 +1,16 @@
 import time
 import random
 import math
+import os
+import sys
 import nbody_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency, use_handles
+
+metrics = KernelMetrics()
+
 # --- Quicksort Implementation (Python - unchanged) ---
 
 def quicksort(arr):
@@ -34,31 +42,44 @@ def quicksort(arr):
     return arr_copy
 
 
-def benchmark_quicksort(data_size, num_runs=10):
-    """Benchmarks the Quicksort algorithm using random arrays."""
-    total_time = 0
-    
+def prepare_quicksort(data_size, num_runs=10):
+    """Generates one random array per run and warms up quicksort()."""
     datasets = [
         [random.random() for _ in range(data_size)]
         for _ in range(num_runs)
     ]
     
     quicksort([random.random() for _ in range(int(data_size * 0.1))])
+    return datasets
+
+
+def benchmark_quicksort(data_size, num_runs=10, inputs=None):
+    """Benchmarks the Quicksort algorithm using random arrays.
+
+    inputs is the result of prepare_quicksort(), generated here if None.
+    """
+    total_time = 0
+    label = f"quicksort n={data_size}"
+    datasets = inputs if inputs is not None else prepare_quicksort(data_size, num_runs)
     
-    for data in datasets:
-        arr_to_sort = data[:]
-        start_time = time.perf_counter()
-        quicksort(arr_to_sort)
-        end_time = time.perf_counter()
+    runs = 0
+    for run in metrics.repetitions(label, num_runs):
+        arr_to_sort = datasets[run % len(datasets)][:]
+        with metrics.measure(label):
+            start_time = time.perf_counter()
+            quicksort(arr_to_sort)
+            end_time = time.perf_counter()
         total_time += (end_time - start_time)
+        runs += 1
     
-    avg_time_ms = (total_time / num_runs) * 1000
+    avg_time_ms = (total_time / runs) * 1000
     
     return {
         "algorithm": "Quicksort",
         "data_size": data_size,
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_time_ms": avg_time_ms,
+        "latency": metrics.latency(label),
     }
 
 
@@ -116,36 +137,76 @@ def nbody_step_update(bodies, dt, G=6.674e-11, softening=1e-9):
 
 # --- N-body Benchmarking Function (SWIG version) ---
 
-def benchmark_nbody(N, num_runs=5, dt=0.01):
-    """Benchmarks a single N-body step update (SWIG version)."""
-    total_time = 0
+def prepare_nbody(N, num_runs=5, dt=0.01):
+    """Generates one copy of the starting state per run and warms up the kernel."""
+    label = f"nbody N={N}"
+    handles = use_handles()
     
     # Generate the starting state (this is only done once)
-    initial_bodies = nbody_swig.initialize_bodies(N, box_size=1000.0)
+    with metrics.span(f"generate {label}"):
+        if handles:
+            initial_bodies = nbody_swig.BodySystemHandle(N, 1000.0)
+            datasets = [nbody_swig.BodySystemHandle(initial_bodies) for _ in range(num_runs)]
+        else:
+            initial_bodies = nbody_swig.initialize_bodies(N, box_size=1000.0)
     
-    # Create fresh copies for each run
-    datasets = [nbody_swig.BodiesVector(initial_bodies) for _ in range(num_runs)]
+            # Create fresh copies for each run
+            datasets = [nbody_swig.BodiesVector(initial_bodies) for _ in range(num_runs)]
     
     # Warm-up run (small number of bodies)
     nbody_swig.nbody_step_update(nbody_swig.initialize_bodies(int(N * 0.1)), dt)
+    return datasets
+
+
+def benchmark_nbody(N, num_runs=5, dt=0.01, inputs=None):
+    """Benchmarks a single N-body step update (SWIG version).
+
+    inputs is the result of prepare_nbody(), generated here if None. The step
+    updates the states in place, so they are good for one call only.
+    """
+    total_time = 0
+    label = f"nbody N={N}"
+    handles = use_handles()
+    datasets = inputs if inputs is not None else prepare_nbody(N, num_runs, dt)
     
-    for bodies in datasets:
-        start_time = time.perf_counter()
-        nbody_swig.nbody_step_update(bodies, dt)
-        end_time = time.perf_counter()
+    # Extra adaptive runs step an already stepped state, which costs the same
+    runs = 0
+    for run in metrics.repetitions(label, num_runs):
+        bodies = datasets[run % len(datasets)]
+        with metrics.measure(label):
+            start_time = time.perf_counter()
+            if handles:
+                bodies.step(dt)
+            else:
+                nbody_swig.nbody_step_update(bodies, dt)
+            end_time = time.perf_counter()
         
         total_time += (end_time - start_time)
+        runs += 1
     
-    avg_time_ms = (total_time / num_runs) * 1000
+    avg_time_ms = (total_time / runs) * 1000
     
     return {
         "algorithm": "N-Body Step Update (O(N^2)) - SWIG",
         "N": N,
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_time_ms": avg_time_ms,
+        "latency": metrics.latency(label),
     }
 
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_quicksort, benchmark_quicksort, (50000, 10)),
+    (prepare_quicksort, benchmark_quicksort, (150000, 5)),
+    (prepare_nbody, benchmark_nbody, (500, 10)),
+    (prepare_nbody, benchmark_nbody, (1500, 3)),
+]
+
+
 # --- Execution ---
 
 if __name__ == "__main__":
@@ -154,8 +215,7 @@ if __name__ == "__main__":
     print("--- Quicksort Benchmark Test Runs ---")
     
     # Test 1: Moderate array size
-    data_size_1 = 50000
-    runs_1 = 10
+    data_size_1, runs_1 = WORKLOADS[0][2]
     print(f"\n--- Benchmarking Quicksort (Array Size: {data_size_1:,}) ---")
     results_1 = benchmark_quicksort(data_size_1, runs_1)
     
@@ -163,12 +223,12 @@ if __name__ == "__main__":
     print(f"Data Size: {results_1['data_size']:,} elements (Random floats)")
     print(f"Total Runs: {results_1['num_runs']}")
     print(f"Average Execution Time: {results_1['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_1['latency'])}")
     
     print("-" * 40)
     
     # Test 2: Larger array size
-    data_size_2 = 150000
-    runs_2 = 5
+    data_size_2, runs_2 = WORKLOADS[1][2]
     print(f"\n--- Benchmarking Quicksort (Array Size: {data_size_2:,}) ---")
     results_2 = benchmark_quicksort(data_size_2, runs_2)
     
@@ -176,6 +236,7 @@ if __name__ == "__main__":
     print(f"Data Size: {results_2['data_size']:,} elements (Random floats)")
     print(f"Total Runs: {results_2['num_runs']}")
     print(f"Average Execution Time: {results_2['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_2['latency'])}")
     
     print("-" * 40)
     print("-" * 40)
@@ -184,8 +245,7 @@ if __name__ == "__main__":
     print("--- N-Body Step Update Benchmark Test Runs (O(N^2)) ---")
     
     # Test 3: Moderate number of bodies
-    N_3 = 500
-    runs_3 = 10
+    N_3, runs_3 = WORKLOADS[2][2]
     print(f"\n--- Benchmarking N-Body (N={N_3:,} bodies) ---")
     results_3 = benchmark_nbody(N_3, runs_3)
     
@@ -193,16 +253,19 @@ if __name__ == "__main__":
     print(f"Number of Bodies (N): {results_3['N']:,}")
     print(f"Total Runs: {results_3['num_runs']}")
     print(f"Average Execution Time: {results_3['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_3['latency'])}")
     
     print("-" * 40)
     
     # Test 4: Larger number of bodies
-    N_4 = 1500
-    runs_4 = 3
+    N_4, runs_4 = WORKLOADS[3][2]
     print(f"\n--- Benchmarking N-Body (N={N_4:,} bodies) ---")
     results_4 = benchmark_nbody(N_4, runs_4)
     
     print(f"Algorithm: {results_4['algorithm']}")
     print(f"Number of Bodies (N): {results_4['N']:,}")
     print(f"Total Runs: {results_4['num_runs']}")
-    print(f"Average Execution Time: {results_4['avg_time_ms']:.4f} ms")
\ No newline at end of file
+    print(f"Average Execution Time: {results_4['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_4['latency'])}")
+    
+    metrics.save()
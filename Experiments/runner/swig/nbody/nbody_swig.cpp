@@ -1,8 +1,11 @@
 // nbody_swig.cpp
 #include "nbody_swig.h"
+#include "kernel_trace.h"
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
+#include <stdexcept>
+#include <string>
 
 BodiesVector initialize_bodies(int N, double box_size, double max_mass) {
     BodiesVector bodies;
@@ -29,18 +32,23 @@ BodiesVector initialize_bodies(int N, double box_size, double max_mass) {
     return bodies;
 }
 
-BodiesVector nbody_step_update(const BodiesVector& bodies, double dt, double G, double softening) {
+// Advances bodies by one step in place. progress is told every 64 bodies of
+// the force loop, and the step stops early, leaving bodies unchanged, once it
+// reports a cancellation
+static void advance_bodies(BodiesVector& bodies, double dt, double G, double softening,
+                           KernelProgress& progress) {
+    KERNEL_TRACE_SPAN("nbody_step_update");
     int N = bodies.size();
     
-    // Create a copy of bodies to update
-    BodiesVector updated_bodies = bodies;
-    
     // Allocate acceleration arrays
     std::vector<double> ax(N, 0.0);
     std::vector<double> ay(N, 0.0);
     
     // 1. Calculate net acceleration (O(N^2) loop)
     for (int i = 0; i < N; i++) {
+        if (i % 64 == 0 && !progress.update(static_cast<double>(i) / N)) {
+            return;
+        }
         const Body& body_i = bodies[i];
         
         for (int j = 0; j < N; j++) {
@@ -65,16 +73,67 @@ BodiesVector nbody_step_update(const BodiesVector& bodies, double dt, double G,
         }
     }
     
-    // 2. Update velocity and position (O(N) loop)
+    // 2. Update velocity and position (O(N) loop); every acceleration is
+    // known by now, so the bodies can be moved in place
     for (int i = 0; i < N; i++) {
         // Update velocity (Euler integration)
-        updated_bodies[i].vx += ax[i] * dt;
-        updated_bodies[i].vy += ay[i] * dt;
+        bodies[i].vx += ax[i] * dt;
+        bodies[i].vy += ay[i] * dt;
         
         // Update position
-        updated_bodies[i].x += updated_bodies[i].vx * dt;
-        updated_bodies[i].y += updated_bodies[i].vy * dt;
+        bodies[i].x += bodies[i].vx * dt;
+        bodies[i].y += bodies[i].vy * dt;
     }
-    
+}
+
+static BodiesVector step_bodies(const BodiesVector& bodies, double dt, double G, double softening,
+                                KernelProgress& progress) {
+    // Create a copy of bodies to update
+    BodiesVector updated_bodies = bodies;
+    advance_bodies(updated_bodies, dt, G, softening, progress);
     return updated_bodies;
-}
\ No newline at end of file
+}
+
+BodiesVector nbody_step_update(const BodiesVector& bodies, double dt, double G, double softening) {
+    KernelProgress progress;
+    return step_bodies(bodies, dt, G, softening, progress);
+}
+
+KernelResultFuture<BodiesVector>* nbody_step_update_async(const BodiesVector& bodies, double dt,
+                                                          double G, double softening) {
+    std::shared_ptr<BodiesVector> input(new BodiesVector(bodies));
+    return submit_kernel<BodiesVector>([input, dt, G, softening](KernelProgress& progress) {
+        return step_bodies(*input, dt, G, softening, progress);
+    });
+}
+
+BodySystemHandle::BodySystemHandle(int N, double box_size, double max_mass)
+    : state(initialize_bodies(N, box_size, max_mass)) {}
+
+BodySystemHandle::BodySystemHandle(const BodiesVector& bodies) : state(bodies) {}
+
+BodySystemHandle::BodySystemHandle(const BodySystemHandle& other) : state(other.state) {}
+
+int BodySystemHandle::size() const {
+    return state.size();
+}
+
+Body BodySystemHandle::get(int i) const {
+    if (i < 0 || i >= static_cast<int>(state.size())) {
+        throw std::out_of_range("BodySystemHandle index " + std::to_string(i) + " out of range");
+    }
+    return state[i];
+}
+
+void BodySystemHandle::step(double dt, double G, double softening) {
+    KernelProgress progress;
+    advance_bodies(state, dt, G, softening, progress);
+}
+
+BodiesVector BodySystemHandle::to_list() const {
+    return state;
+}
+
+const BodiesVector& BodySystemHandle::bodies() const {
+    return state;
+}
@@ -2,6 +2,8 @@
 #ifndef NBODY_SWIG_H
 #define NBODY_SWIG_H
 
+#include "kernel_async.h"
+
 #include <vector>
 
 // Body structure
@@ -26,4 +28,38 @@ BodiesVector initialize_bodies(int N, double box_size = 1000.0, double max_mass
 BodiesVector nbody_step_update(const BodiesVector& bodies, double dt, 
                                 double G = 6.674e-11, double softening = 1e-9);
 
+// nbody_step_update() on the kernel thread pool. bodies is copied, so the
+// caller may drop it; progress advances every 64 bodies and cancel() stops
+// the step there.
+KernelResultFuture<BodiesVector>* nbody_step_update_async(const BodiesVector& bodies, double dt,
+                                                          double G = 6.674e-11, double softening = 1e-9);
+
+// Bodies kept in C++ across calls: step() advances them in place, so no
+// BodiesVector is copied or converted per step; to_list() exports them
+class BodySystemHandle {
+public:
+    // N random bodies, as initialize_bodies()
+    BodySystemHandle(int N, double box_size = 1000.0, double max_mass = 1.0);
+    explicit BodySystemHandle(const BodiesVector& bodies);
+    BodySystemHandle(const BodySystemHandle& other);
+
+    int size() const;
+    // Throws std::out_of_range outside size() (IndexError in Python)
+    Body get(int i) const;
+
+    // One nbody_step_update() of every body
+    void step(double dt, double G = 6.674e-11, double softening = 1e-9);
+
+    BodiesVector to_list() const;
+
+#ifndef SWIG
+    const BodiesVector& bodies() const;
+#endif
+
+private:
+    BodySystemHandle& operator=(const BodySystemHandle&);
+
+    BodiesVector state;
+};
+
 #endif // NBODY_SWIG_H
\ No newline at end of file
@@ -6,14 +6,43 @@
 %}
 
 %include "std_vector.i"
+%include "std_string.i"
+%include "exception.i"
 
-// Make Body structure accessible from Python
-%include "nbody_swig.h"
+// get() outside the system raises IndexError
+%exception BodySystemHandle::get {
+    try {
+        $action
+    } catch (const std::out_of_range& e) {
+        SWIG_exception(SWIG_IndexError, e.what());
+    }
+}
+
+// result() before a successful finish raises RuntimeError
+%exception KernelResultFuture<std::vector<Body> >::result {
+    try {
+        $action
+    } catch (const std::runtime_error& e) {
+        SWIG_exception(SWIG_RuntimeError, e.what());
+    }
+}
+
+%include "kernel_async.h"
 
+%newobject nbody_step_update_async;
+
+// Instantiated before the header, so the functions taking or returning
+// BodiesVector get its sequence typemaps rather than an opaque pointer
+struct Body;
 namespace std {
     %template(BodiesVector) vector<Body>;
 }
 
+// Make Body structure accessible from Python
+%include "nbody_swig.h"
+
+%template(BodiesFuture) KernelResultFuture<std::vector<Body> >;
+
 // Allow Python to access Body fields
 %extend Body {
     %pythoncode %{
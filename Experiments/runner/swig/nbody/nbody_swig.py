@@ -1,258 +0,0 @@
-# This file was automatically generated by SWIG (http://www.swig.org).
-# Version 4.0.2
-#
-# Do not make changes to this file unless you know what you are doing--modify
-# the SWIG interface file instead.
-
-from sys import version_info as _swig_python_version_info
-if _swig_python_version_info < (2, 7, 0):
-    raise RuntimeError("Python 2.7 or later required")
-
-# Import the low-level C/C++ module
-if __package__ or "." in __name__:
-    from . import _nbody_swig
-else:
-    import _nbody_swig
-
-try:
-    import builtins as __builtin__
-except ImportError:
-    import __builtin__
-
-def _swig_repr(self):
-    try:
-        strthis = "proxy of " + self.this.__repr__()
-    except __builtin__.Exception:
-        strthis = ""
-    return "<%s.%s; %s >" % (self.__class__.__module__, self.__class__.__name__, strthis,)
-
-
-def _swig_setattr_nondynamic_instance_variable(set):
-    def set_instance_attr(self, name, value):
-        if name == "thisown":
-            self.this.own(value)
-        elif name == "this":
-            set(self, name, value)
-        elif hasattr(self, name) and isinstance(getattr(type(self), name), property):
-            set(self, name, value)
-        else:
-            raise AttributeError("You cannot add instance attributes to %s" % self)
-    return set_instance_attr
-
-
-def _swig_setattr_nondynamic_class_variable(set):
-    def set_class_attr(cls, name, value):
-        if hasattr(cls, name) and not isinstance(getattr(cls, name), property):
-            set(cls, name, value)
-        else:
-            raise AttributeError("You cannot add class attributes to %s" % cls)
-    return set_class_attr
-
-
-def _swig_add_metaclass(metaclass):
-    """Class decorator for adding a metaclass to a SWIG wrapped class - a slimmed down version of six.add_metaclass"""
-    def wrapper(cls):
-        return metaclass(cls.__name__, cls.__bases__, cls.__dict__.copy())
-    return wrapper
-
-
-class _SwigNonDynamicMeta(type):
-    """Meta class to enforce nondynamic attributes (no new attributes) for a class"""
-    __setattr__ = _swig_setattr_nondynamic_class_variable(type.__setattr__)
-
-
-class SwigPyIterator(object):
-    thisown = property(lambda x: x.this.own(), lambda x, v: x.this.own(v), doc="The membership flag")
-
-    def __init__(self, *args, **kwargs):
-        raise AttributeError("No constructor defined - class is abstract")
-    __repr__ = _swig_repr
-    __swig_destroy__ = _nbody_swig.delete_SwigPyIterator
-
-    def value(self):
-        return _nbody_swig.SwigPyIterator_value(self)
-
-    def incr(self, n=1):
-        return _nbody_swig.SwigPyIterator_incr(self, n)
-
-    def decr(self, n=1):
-        return _nbody_swig.SwigPyIterator_decr(self, n)
-
-    def distance(self, x):
-        return _nbody_swig.SwigPyIterator_distance(self, x)
-
-    def equal(self, x):
-        return _nbody_swig.SwigPyIterator_equal(self, x)
-
-    def copy(self):
-        return _nbody_swig.SwigPyIterator_copy(self)
-
-    def next(self):
-        return _nbody_swig.SwigPyIterator_next(self)
-
-    def __next__(self):
-        return _nbody_swig.SwigPyIterator___next__(self)
-
-    def previous(self):
-        return _nbody_swig.SwigPyIterator_previous(self)
-
-    def advance(self, n):
-        return _nbody_swig.SwigPyIterator_advance(self, n)
-
-    def __eq__(self, x):
-        return _nbody_swig.SwigPyIterator___eq__(self, x)
-
-    def __ne__(self, x):
-        return _nbody_swig.SwigPyIterator___ne__(self, x)
-
-    def __iadd__(self, n):
-        return _nbody_swig.SwigPyIterator___iadd__(self, n)
-
-    def __isub__(self, n):
-        return _nbody_swig.SwigPyIterator___isub__(self, n)
-
-    def __add__(self, n):
-        return _nbody_swig.SwigPyIterator___add__(self, n)
-
-    def __sub__(self, *args):
-        return _nbody_swig.SwigPyIterator___sub__(self, *args)
-    def __iter__(self):
-        return self
-
-# Register SwigPyIterator in _nbody_swig:
-_nbody_swig.SwigPyIterator_swigregister(SwigPyIterator)
-
-class Body(object):
-    thisown = property(lambda x: x.this.own(), lambda x, v: x.this.own(v), doc="The membership flag")
-    __repr__ = _swig_repr
-    x = property(_nbody_swig.Body_x_get, _nbody_swig.Body_x_set)
-    y = property(_nbody_swig.Body_y_get, _nbody_swig.Body_y_set)
-    vx = property(_nbody_swig.Body_vx_get, _nbody_swig.Body_vx_set)
-    vy = property(_nbody_swig.Body_vy_get, _nbody_swig.Body_vy_set)
-    m = property(_nbody_swig.Body_m_get, _nbody_swig.Body_m_set)
-
-    def __init__(self, *args):
-        _nbody_swig.Body_swiginit(self, _nbody_swig.new_Body(*args))
-
-    def __repr__(self):
-        return f"Body(x={self.x:.2f}, y={self.y:.2f}, vx={self.vx:.2f}, vy={self.vy:.2f}, m={self.m:.2f})"
-
-    __swig_destroy__ = _nbody_swig.delete_Body
-
-# Register Body in _nbody_swig:
-_nbody_swig.Body_swigregister(Body)
-
-
-def initialize_bodies(N, box_size=1000.0, max_mass=1.0):
-    return _nbody_swig.initialize_bodies(N, box_size, max_mass)
-
-def nbody_step_update(bodies, dt, G=6.674e-11, softening=1e-9):
-    return _nbody_swig.nbody_step_update(bodies, dt, G, softening)
-class BodiesVector(object):
-    thisown = property(lambda x: x.this.own(), lambda x, v: x.this.own(v), doc="The membership flag")
-    __repr__ = _swig_repr
-
-    def iterator(self):
-        return _nbody_swig.BodiesVector_iterator(self)
-    def __iter__(self):
-        return self.iterator()
-
-    def __nonzero__(self):
-        return _nbody_swig.BodiesVector___nonzero__(self)
-
-    def __bool__(self):
-        return _nbody_swig.BodiesVector___bool__(self)
-
-    def __len__(self):
-        return _nbody_swig.BodiesVector___len__(self)
-
-    def __getslice__(self, i, j):
-        return _nbody_swig.BodiesVector___getslice__(self, i, j)
-
-    def __setslice__(self, *args):
-        return _nbody_swig.BodiesVector___setslice__(self, *args)
-
-    def __delslice__(self, i, j):
-        return _nbody_swig.BodiesVector___delslice__(self, i, j)
-
-    def __delitem__(self, *args):
-        return _nbody_swig.BodiesVector___delitem__(self, *args)
-
-    def __getitem__(self, *args):
-        return _nbody_swig.BodiesVector___getitem__(self, *args)
-
-    def __setitem__(self, *args):
-        return _nbody_swig.BodiesVector___setitem__(self, *args)
-
-    def pop(self):
-        return _nbody_swig.BodiesVector_pop(self)
-
-    def append(self, x):
-        return _nbody_swig.BodiesVector_append(self, x)
-
-    def empty(self):
-        return _nbody_swig.BodiesVector_empty(self)
-
-    def size(self):
-        return _nbody_swig.BodiesVector_size(self)
-
-    def swap(self, v):
-        return _nbody_swig.BodiesVector_swap(self, v)
-
-    def begin(self):
-        return _nbody_swig.BodiesVector_begin(self)
-
-    def end(self):
-        return _nbody_swig.BodiesVector_end(self)
-
-    def rbegin(self):
-        return _nbody_swig.BodiesVector_rbegin(self)
-
-    def rend(self):
-        return _nbody_swig.BodiesVector_rend(self)
-
-    def clear(self):
-        return _nbody_swig.BodiesVector_clear(self)
-
-    def get_allocator(self):
-        return _nbody_swig.BodiesVector_get_allocator(self)
-
-    def pop_back(self):
-        return _nbody_swig.BodiesVector_pop_back(self)
-
-    def erase(self, *args):
-        return _nbody_swig.BodiesVector_erase(self, *args)
-
-    def __init__(self, *args):
-        _nbody_swig.BodiesVector_swiginit(self, _nbody_swig.new_BodiesVector(*args))
-
-    def push_back(self, x):
-        return _nbody_swig.BodiesVector_push_back(self, x)
-
-    def front(self):
-        return _nbody_swig.BodiesVector_front(self)
-
-    def back(self):
-        return _nbody_swig.BodiesVector_back(self)
-
-    def assign(self, n, x):
-        return _nbody_swig.BodiesVector_assign(self, n, x)
-
-    def resize(self, *args):
-        return _nbody_swig.BodiesVector_resize(self, *args)
-
-    def insert(self, *args):
-        return _nbody_swig.BodiesVector_insert(self, *args)
-
-    def reserve(self, n):
-        return _nbody_swig.BodiesVector_reserve(self, n)
-
-    def capacity(self):
-        return _nbody_swig.BodiesVector_capacity(self)
-    __swig_destroy__ = _nbody_swig.delete_BodiesVector
-
-# Register BodiesVector in _nbody_swig:
-_nbody_swig.BodiesVector_swigregister(BodiesVector)
-
-
-
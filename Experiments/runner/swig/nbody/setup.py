@@ -4,8 +4,14 @@ from setuptools import setup, Extension
 nbody_module = Extension(
     '_nbody_swig',
     sources=['nbody_swig.i', 'nbody_swig.cpp'],
-    swig_opts=['-c++'],
-    extra_compile_args=['-O3', '-std=c++11', '-ffast-math'],
+    swig_opts=['-c++', '-I../async'],
+    include_dirs=['../instrument', '../async'],  # kernel_trace.h, kernel_async.h
+    # One kernel thread pool per process, shared with the other async modules
+    # (make -C ../../native build/libkernel_async.so)
+    library_dirs=['../../native/build'],
+    libraries=['kernel_async', 'dl'],
+    extra_compile_args=['-O3', '-std=c++11', '-ffast-math', '-pthread'],
+    extra_link_args=['-pthread', '-Wl,-rpath,$ORIGIN/../../native/build'],
 )
 
 setup(
@@ -1,7 +1,15 @@
 import time
 import random
+import os
+import sys
 import quicksort_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency
+
+metrics = KernelMetrics()
+
 # --- Quicksort Implementation ---
 
 def quicksort(arr):
@@ -43,49 +51,74 @@ def quicksort(arr):
 
 # --- Benchmarking Function ---
 
-def benchmark_quicksort(data_size, num_runs=10):
+def prepare_quicksort(data_size, num_runs=10):
+    """Generates one random array per run and warms up the kernel."""
+    label = f"n={data_size}"
+    
+    # Generate the set of arrays to sort outside the timing loop
+    # We use a fresh random array for each run to avoid best/worst-case bias
+    with metrics.span(f"generate {label}"):
+        datasets = [
+            [random.random() for _ in range(data_size)]
+            for _ in range(num_runs)
+        ]
+    
+    # Warm-up run
+    # Perform a quick, small sort
+    warmup_data = [random.random() for _ in range(int(data_size * 0.1))]
+    quicksort_swig.quicksort(warmup_data)
+    return datasets
+
+
+def benchmark_quicksort(data_size, num_runs=10, inputs=None):
     """
     Benchmarks the Quicksort algorithm using random arrays (SWIG version).
     
     Args:
         data_size (int): The number of elements in the array to sort.
         num_runs (int): The number of times to run the sort for averaging.
+        inputs: Result of prepare_quicksort(data_size, num_runs), generated here if None.
         
     Returns:
         dict: Results including average time.
     """
     total_time = 0
+    label = f"n={data_size}"
+    datasets = inputs if inputs is not None else prepare_quicksort(data_size, num_runs)
     
-    # Generate the set of arrays to sort outside the timing loop
-    # We use a fresh random array for each run to avoid best/worst-case bias
-    datasets = [
-        [random.random() for _ in range(data_size)]
-        for _ in range(num_runs)
-    ]
-    
-    # Warm-up run
-    # Perform a quick, small sort
-    warmup_data = [random.random() for _ in range(int(data_size * 0.1))]
-    quicksort_swig.quicksort(warmup_data)
-    
-    for data in datasets:
+    runs = 0
+    for run in metrics.repetitions(label, num_runs):
+        data = datasets[run % len(datasets)]
         # SWIG version expects a list and returns a sorted vector
-        start_time = time.perf_counter()
-        sorted_result = quicksort_swig.quicksort(data)
-        end_time = time.perf_counter()
+        with metrics.measure(label):
+            start_time = time.perf_counter()
+            sorted_result = quicksort_swig.quicksort(data)
+            end_time = time.perf_counter()
         
         total_time += (end_time - start_time)
+        runs += 1
     
-    avg_time_ms = (total_time / num_runs) * 1000
+    avg_time_ms = (total_time / runs) * 1000
     
     return {
         "algorithm": "Quicksort (SWIG)",
         "data_size": data_size,
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_time_ms": avg_time_ms,
+        "latency": metrics.latency(label),
     }
 
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_quicksort, benchmark_quicksort, (50000, 10)),
+    (prepare_quicksort, benchmark_quicksort, (150000, 5)),
+]
+
+
 # --- Execution ---
 
 if __name__ == "__main__":
@@ -93,8 +126,7 @@ if __name__ == "__main__":
     print("--- Quicksort Benchmark Test Runs (SWIG) ---")
     
     # Test 1: Moderate array size
-    data_size_1 = 50000
-    runs_1 = 10
+    data_size_1, runs_1 = WORKLOADS[0][2]
     
     print(f"\n--- Benchmarking Quicksort (Array Size: {data_size_1:,}) ---")
     results_1 = benchmark_quicksort(data_size_1, runs_1)
@@ -103,12 +135,12 @@ if __name__ == "__main__":
     print(f"Data Size: {results_1['data_size']:,} elements (Random floats)")
     print(f"Total Runs: {results_1['num_runs']}")
     print(f"Average Execution Time: {results_1['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_1['latency'])}")
     
     print("-" * 40)
     
     # Test 2: Larger array size
-    data_size_2 = 150000
-    runs_2 = 5
+    data_size_2, runs_2 = WORKLOADS[1][2]
     
     print(f"\n--- Benchmarking Quicksort (Array Size: {data_size_2:,}) ---")
     results_2 = benchmark_quicksort(data_size_2, runs_2)
@@ -116,4 +148,7 @@ if __name__ == "__main__":
     print(f"Algorithm: {results_2['algorithm']}")
     print(f"Data Size: {results_2['data_size']:,} elements (Random floats)")
     print(f"Total Runs: {results_2['num_runs']}")
-    print(f"Average Execution Time: {results_2['avg_time_ms']:.4f} ms")
\ No newline at end of file
+    print(f"Average Execution Time: {results_2['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_2['latency'])}")
+    
+    metrics.save()
@@ -1,5 +1,6 @@
 // quicksort_swig.cpp
 #include "quicksort_swig.h"
+#include "kernel_trace.h"
 
 // Partition function for quicksort
 static int partition(std::vector<double>& items, int low, int high) {
@@ -36,6 +37,7 @@ static void quicksort_recursive(std::vector<double>& items, int low, int high) {
 }
 
 std::vector<double> quicksort(const std::vector<double>& arr) {
+    KERNEL_TRACE_SPAN("quicksort");
     // Create a copy
     std::vector<double> arr_copy = arr;
     
@@ -47,6 +49,7 @@ std::vector<double> quicksort(const std::vector<double>& arr) {
 }
 
 void quicksort_inplace(std::vector<double>& arr) {
+    KERNEL_TRACE_SPAN("quicksort_inplace");
     if (!arr.empty()) {
         quicksort_recursive(arr, 0, arr.size() - 1);
     }
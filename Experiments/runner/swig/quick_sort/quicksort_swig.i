@@ -11,4 +11,7 @@ namespace std {
     %template(DoubleVector) vector<double>;
 }
 
+%include "move_result.i"
+%move_result(std::vector<double>, quicksort);
+
 %include "quicksort_swig.h"
\ No newline at end of file
@@ -4,7 +4,9 @@ from setuptools import setup, Extension
 quicksort_module = Extension(
     '_quicksort_swig',
     sources=['quicksort_swig.i', 'quicksort_swig.cpp'],
-    swig_opts=['-c++'],
+    swig_opts=['-c++', '-I../transfer'],  # move_result.i
+    include_dirs=['../instrument'],  # kernel_trace.h
+    libraries=['dl'],
     extra_compile_args=['-O3', '-std=c++11'],
 )
 
@@ -1,8 +1,16 @@
 import time
 import random
 import re
+import os
+import sys
 import regex_swig
 
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency
+
+metrics = KernelMetrics()
+
 # --- Regular Expression Tokenization Implementation ---
 
 # Complex pattern to simulate a "heavy" tokenization load
@@ -29,7 +37,33 @@ def regex_tokenize(text, pattern=TOKENIZATION_PATTERN):
 
 # --- Tokenization Benchmarking Function ---
 
-def benchmark_tokenizer(text_size_kb, num_runs=5, method='swig'):
+def prepare_tokenizer(text_size_kb, num_runs=5, method='swig'):
+    """Generates the input text for benchmark_tokenizer() and warms up the method."""
+    label = f"{method} {text_size_kb}KB"
+    
+    # 1. Generate the test data
+    with metrics.span(f"generate {label}"):
+        base_corpus = "The quick brown fox jumps over the lazy dog's fence. " * 10
+    
+        target_size_bytes = text_size_kb * 1024
+        data_text = base_corpus * (target_size_bytes // len(base_corpus) + 1)
+        data_text = data_text[:target_size_bytes] 
+    
+        # Add complexity
+        def add_complexity(text):
+            return text.replace("fox", "12345.67 fox") + " https://example.com/page?id=1"
+        
+        data_text = add_complexity(data_text)
+    
+    # Warm-up run
+    if method == 'swig':
+        regex_swig.simple_tokenize(data_text[:1000])
+    else:
+        regex_tokenize(data_text[:1000])
+    return data_text
+
+
+def benchmark_tokenizer(text_size_kb, num_runs=5, method='swig', inputs=None):
     """
     Benchmarks the tokenization process.
     
@@ -37,48 +71,35 @@ def benchmark_tokenizer(text_size_kb, num_runs=5, method='swig'):
         text_size_kb (int): The target size of the input text in kilobytes (KB).
         num_runs (int): The number of times to run the tokenization for averaging.
         method (str): 'swig' for SWIG implementation, 'regex' for Python regex
+        inputs: Result of prepare_tokenizer(), generated here if None.
         
     Returns:
         dict: Results including average time.
     """
     total_time = 0
+    label = f"{method} {text_size_kb}KB"
+    data_text = inputs if inputs is not None else prepare_tokenizer(text_size_kb, num_runs, method)
     
-    # 1. Generate the test data
-    base_corpus = "The quick brown fox jumps over the lazy dog's fence. " * 10
-    
-    target_size_bytes = text_size_kb * 1024
-    data_text = base_corpus * (target_size_bytes // len(base_corpus) + 1)
-    data_text = data_text[:target_size_bytes] 
-    
-    # Add complexity
-    def add_complexity(text):
-        return text.replace("fox", "12345.67 fox") + " https://example.com/page?id=1"
+    runs = 0
+    for _ in metrics.repetitions(label, num_runs):
+        with metrics.measure(label):
+            start_time = time.perf_counter()
         
-    data_text = add_complexity(data_text)
-    
-    # Warm-up run
-    if method == 'swig':
-        regex_swig.simple_tokenize(data_text[:1000])
-    else:
-        regex_tokenize(data_text[:1000])
-    
-    for _ in range(num_runs):
-        start_time = time.perf_counter()
-        
-        # Execute the tokenization
-        if method == 'swig':
-            tokens = regex_swig.simple_tokenize(data_text)
-        elif method == 'fast_swig':
-            tokens = regex_swig.fast_word_tokenize(data_text)
-        elif method == 'char_swig':
-            tokens = regex_swig.char_tokenize(data_text)
-        else:
-            tokens = regex_tokenize(data_text)
+            # Execute the tokenization
+            if method == 'swig':
+                tokens = regex_swig.simple_tokenize(data_text)
+            elif method == 'fast_swig':
+                tokens = regex_swig.fast_word_tokenize(data_text)
+            elif method == 'char_swig':
+                tokens = regex_swig.char_tokenize(data_text)
+            else:
+                tokens = regex_tokenize(data_text)
         
-        end_time = time.perf_counter()
+            end_time = time.perf_counter()
         total_time += (end_time - start_time)
+        runs += 1
 
-    avg_time_ms = (total_time / num_runs) * 1000
+    avg_time_ms = (total_time / runs) * 1000
     
     method_name = {
         'swig': 'Simple Tokenize (SWIG)',
@@ -91,11 +112,24 @@ def benchmark_tokenizer(text_size_kb, num_runs=5, method='swig'):
         "algorithm": f"Tokenization - {method_name}",
         "text_size_kb": text_size_kb,
         "token_count": len(tokens) if 'tokens' in locals() else 'N/A',
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_time_ms": avg_time_ms,
+        "latency": metrics.latency(label),
     }
 
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_tokenizer, benchmark_tokenizer, (200, 10, 'swig')),
+    (prepare_tokenizer, benchmark_tokenizer, (200, 10, 'fast_swig')),
+    (prepare_tokenizer, benchmark_tokenizer, (800, 5, 'swig')),
+    (prepare_tokenizer, benchmark_tokenizer, (800, 5, 'fast_swig')),
+]
+
+
 # --- Execution ---
 
 if __name__ == "__main__":
@@ -105,47 +139,51 @@ if __name__ == "__main__":
     print("-" * 60)
     
     # --- Tokenization Benchmark Test 1: Moderate Text Size ---
-    text_size_kb_1 = 200 # 200 KB
-    runs1 = 10
+    text_size_kb_1, runs1, _ = WORKLOADS[0][2]  # 200 KB
     
     print(f"\n--- Test 1: Text Size {text_size_kb_1} KB ---")
     
     # Test SWIG simple tokenizer
-    results1_swig = benchmark_tokenizer(text_size_kb_1, runs1, method='swig')
+    results1_swig = benchmark_tokenizer(*WORKLOADS[0][2])
     print(f"Algorithm: {results1_swig['algorithm']}")
     print(f"Text Size: {results1_swig['text_size_kb']} KB")
     print(f"Approx. Tokens: {results1_swig['token_count']:,}")
     print(f"Total Runs: {results1_swig['num_runs']}")
     print(f"Average Execution Time: {results1_swig['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results1_swig['latency'])}")
     
     print()
     
     # Test SWIG fast word tokenizer
-    results1_fast = benchmark_tokenizer(text_size_kb_1, runs1, method='fast_swig')
+    results1_fast = benchmark_tokenizer(*WORKLOADS[1][2])
     print(f"Algorithm: {results1_fast['algorithm']}")
     print(f"Average Execution Time: {results1_fast['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results1_fast['latency'])}")
     
     print("-" * 60)
     
     # --- Tokenization Benchmark Test 2: Larger Text Size ---
-    text_size_kb_2 = 800 # 800 KB
-    runs2 = 5
+    text_size_kb_2, runs2, _ = WORKLOADS[2][2]  # 800 KB
     
     print(f"\n--- Test 2: Text Size {text_size_kb_2} KB ---")
     
     # Test SWIG simple tokenizer
-    results2_swig = benchmark_tokenizer(text_size_kb_2, runs2, method='swig')
+    results2_swig = benchmark_tokenizer(*WORKLOADS[2][2])
     print(f"Algorithm: {results2_swig['algorithm']}")
     print(f"Text Size: {results2_swig['text_size_kb']} KB")
     print(f"Approx. Tokens: {results2_swig['token_count']:,}")
     print(f"Total Runs: {results2_swig['num_runs']}")
     print(f"Average Execution Time: {results2_swig['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results2_swig['latency'])}")
     
     print()
     
     # Test SWIG fast word tokenizer
-    results2_fast = benchmark_tokenizer(text_size_kb_2, runs2, method='fast_swig')
+    results2_fast = benchmark_tokenizer(*WORKLOADS[3][2])
     print(f"Algorithm: {results2_fast['algorithm']}")
     print(f"Average Execution Time: {results2_fast['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results2_fast['latency'])}")
+    
+    print("-" * 60)
     
-    print("-" * 60)
\ No newline at end of file
+    metrics.save()
@@ -1,5 +1,6 @@
 // regex_swig.cpp
 #include "regex_swig.h"
+#include "kernel_trace.h"
 #include <cctype>
 #include <sstream>
 
@@ -24,6 +25,7 @@ inline bool is_punctuation(char c) {
 }
 
 std::vector<std::string> simple_tokenize(const std::string& text) {
+    KERNEL_TRACE_SPAN("simple_tokenize");
     std::vector<std::string> tokens;
     size_t length = text.length();
     size_t start = 0;
@@ -64,6 +66,7 @@ std::vector<std::string> simple_tokenize(const std::string& text) {
 }
 
 std::vector<std::string> fast_word_tokenize(const std::string& text) {
+    KERNEL_TRACE_SPAN("fast_word_tokenize");
     std::vector<std::string> tokens;
     size_t length = text.length();
     size_t start = 0;
@@ -94,6 +97,7 @@ std::vector<std::string> fast_word_tokenize(const std::string& text) {
 }
 
 std::vector<std::string> char_tokenize(const std::string& text) {
+    KERNEL_TRACE_SPAN("char_tokenize");
     std::vector<std::string> tokens;
     size_t length = text.length();
     
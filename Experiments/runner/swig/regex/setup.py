@@ -5,6 +5,8 @@ regex_module = Extension(
     '_regex_swig',
     sources=['regex_swig.i', 'regex_swig.cpp'],
     swig_opts=['-c++'],
+    include_dirs=['../instrument'],  # kernel_trace.h
+    libraries=['dl'],
     extra_compile_args=['-O3', '-std=c++11'],
 )
 
@@ -1,56 +1,88 @@
 import time
+import os
+import sys
 import sieve_swig
 
-def benchmark_sieve(limit, num_runs=10):
+# Shared measurement helpers live in ../instrument
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "instrument"))
+from kernel_metrics import KernelMetrics, format_latency
+
+metrics = KernelMetrics()
+
+def prepare_sieve(limit, num_runs=10):
+    """Warms up the kernel; the sieve has no input data, so the result is empty."""
+    # Warming up
+    sieve_swig.sieve_of_eratosthenes(int(limit * 0.1))
+    return ()
+
+
+def benchmark_sieve(limit, num_runs=10, inputs=None):
     """
     Benchmarks the Sieve of Eratosthenes algorithm (SWIG version).
     Args:
         limit (int): The upper limit for finding primes.
         num_runs (int): The number of times to run the sieve for averaging.
+        inputs: Result of prepare_sieve(limit, num_runs), which runs here if None.
     Returns:
         dict: Results including average time and the number of primes found.
     """
     total_time = 0
     prime_count = 0
+    label = f"limit={limit}"
     
-    # Warming up
-    sieve_swig.sieve_of_eratosthenes(int(limit * 0.1))
+    if inputs is None:
+        prepare_sieve(limit, num_runs)
     
-    for _ in range(num_runs):
-        start_time = time.perf_counter()
-        primes = sieve_swig.sieve_of_eratosthenes(limit)
-        end_time = time.perf_counter()
+    runs = 0
+    for _ in metrics.repetitions(label, num_runs):
+        with metrics.measure(label):
+            start_time = time.perf_counter()
+            primes = sieve_swig.sieve_of_eratosthenes(limit)
+            end_time = time.perf_counter()
         total_time += (end_time - start_time)
         prime_count = len(primes)
+        runs += 1
     
-    avg_time_ms = (total_time / num_runs) * 1000
+    avg_time_ms = (total_time / runs) * 1000
     
     return {
         "limit": limit,
-        "num_runs": num_runs,
+        "num_runs": runs,
         "avg_time_ms": avg_time_ms,
+        "latency": metrics.latency(label),
         "prime_count": prime_count,
     }
 
+# --- Workloads ---
+
+# (prepare, benchmark, arguments) of each test below; runner/worker.py
+# replays the same list
+WORKLOADS = [
+    (prepare_sieve, benchmark_sieve, (100000, 20)),
+    (prepare_sieve, benchmark_sieve, (1000000, 5)),
+]
+
 # --- Execution ---
 if __name__ == "__main__":
     # Test 1: Finding primes up to a moderate limit
-    limit_1 = 100000
-    runs_1 = 20
+    limit_1, runs_1 = WORKLOADS[0][2]
     print(f"--- Benchmarking Sieve of Eratosthenes (Limit: {limit_1:,}) ---")
     results_1 = benchmark_sieve(limit_1, runs_1)
     print(f"Limit: {results_1['limit']:,}")
     print(f"Primes Found: {results_1['prime_count']:,}")
     print(f"Total Runs: {results_1['num_runs']}")
     print(f"Average Execution Time: {results_1['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_1['latency'])}")
     print("-" * 40)
     
     # Test 2: Finding primes up to a larger limit
-    limit_2 = 1000000
-    runs_2 = 5
+    limit_2, runs_2 = WORKLOADS[1][2]
     print(f"--- Benchmarking Sieve of Eratosthenes (Limit: {limit_2:,}) ---")
     results_2 = benchmark_sieve(limit_2, runs_2)
     print(f"Limit: {results_2['limit']:,}")
     print(f"Primes Found: {results_2['prime_count']:,}")
     print(f"Total Runs: {results_2['num_runs']}")
-    print(f"Average Execution Time: {results_2['avg_time_ms']:.4f} ms")
\ No newline at end of file
+    print(f"Average Execution Time: {results_2['avg_time_ms']:.4f} ms")
+    print(f"Latency: {format_latency(results_2['latency'])}")
+    
+    metrics.save()
@@ -5,6 +5,8 @@ sieve_module = Extension(
     '_sieve_swig',
     sources=['sieve_swig.i', 'sieve_swig.cpp'],
     swig_opts=['-c++'],
+    include_dirs=['../instrument'],  # kernel_trace.h
+    libraries=['dl'],
     extra_compile_args=['-O3', '-std=c++11'],
 )
 
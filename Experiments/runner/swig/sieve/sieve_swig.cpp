@@ -1,8 +1,10 @@
 // sieve_swig.cpp
 #include "sieve_swig.h"
+#include "kernel_trace.h"
 #include <cstring>
 
 std::vector<int> sieve_of_eratosthenes(int limit) {
+    KERNEL_TRACE_SPAN("sieve_of_eratosthenes");
     std::vector<int> primes;
     
     if (limit < 2) {
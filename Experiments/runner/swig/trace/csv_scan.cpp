@@ -0,0 +1,147 @@
+// csv_scan.cpp
+#include "csv_scan.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) : data_(NULL), size_(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = path + ": " + std::strerror(errno);
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        error_ = path + ": empty or unreadable";
+        close(fd);
+        return;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        error_ = path + ": " + std::strerror(errno);
+        return;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+    size_ = size;
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+const char* find_delimiter(const char* p, const char* end) {
+#ifdef __SSE2__
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, comma),
+                                                  _mm_cmpeq_epi8(chunk, newline)));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != ',' && *p != '\n') {
+        p++;
+    }
+    return p;
+}
+
+const char* find_newline(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', end - p);
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+static double slow_parse(const char* p, const char* end, bool& valid) {
+    std::string text(p, end);
+    char* stop;
+    double value = std::strtod(text.c_str(), &stop);
+    valid = stop != text.c_str() && *stop == '\0';
+    return value;
+}
+
+// Parses [-+]digits[.digits][e[-+]digits]. Exact for up to 15 significant
+// digits; longer mantissas may differ from strtod in the last bit.
+bool parse_number(const char* p, const char* end, double& value) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char* start = p;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+    for (; p < end && unsigned(*p - '0') < 10; p++, any = true) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && unsigned(*p - '0') < 10; p++, any = true) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!any) {
+        // NaN, inf and other text go through strtod
+        bool valid;
+        value = slow_parse(start, end, valid);
+        return valid;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool exp_negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exp_negative = *p == '-';
+            p++;
+        }
+        int exp_value = 0;
+        for (; p < end && unsigned(*p - '0') < 10; p++) {
+            if (exp_value < 10000) exp_value = exp_value * 10 + (*p - '0');
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    if (p != end) {
+        return false;
+    }
+
+    if (exponent < -22 || exponent > 22) {
+        bool valid;
+        value = slow_parse(start, end, valid);
+        return valid;
+    }
+    double result = static_cast<double>(mantissa);
+    result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+    value = negative ? -result : result;
+    return true;
+}
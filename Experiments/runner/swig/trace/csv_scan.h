@@ -0,0 +1,37 @@
+// csv_scan.h
+#ifndef CSV_SCAN_H
+#define CSV_SCAN_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only mmap of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    bool ok() const { return data_ != NULL; }
+    const std::string& error() const { return error_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+    const char* data_;
+    size_t size_;
+    std::string error_;
+};
+
+// Next ',' or '\n' at or after p, or end (SSE2 when available)
+const char* find_delimiter(const char* p, const char* end);
+
+// Next '\n' at or after p, or end
+const char* find_newline(const char* p, const char* end);
+
+// Parses one CSV number in [p, end); false if the field is not a number
+bool parse_number(const char* p, const char* end, double& value);
+
+#endif
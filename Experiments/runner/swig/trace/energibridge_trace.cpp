@@ -0,0 +1,115 @@
+// energibridge_trace.cpp
+#include "energibridge_trace.h"
+#include "csv_scan.h"
+
+ColumnStats::ColumnStats()
+    : count(0), first(0.0), last(0.0), min(0.0), max(0.0), sum(0.0) {}
+
+double ColumnStats::mean() const {
+    return count > 0 ? sum / count : 0.0;
+}
+
+double ColumnStats::delta() const {
+    return last - first;
+}
+
+static bool matches(const std::string& name, const std::vector<std::string>& selectors) {
+    for (size_t i = 0; i < selectors.size(); i++) {
+        const std::string& s = selectors[i];
+        if (!s.empty() && s[s.size() - 1] == '*') {
+            if (name.compare(0, s.size() - 1, s, 0, s.size() - 1) == 0) {
+                return true;
+            }
+        } else if (name == s) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TraceSummary::TraceSummary(const std::string& path, const std::vector<std::string>& selectors)
+    : row_count(0) {
+    MappedFile file(path);
+    if (!file.ok()) {
+        error_message = file.error();
+        return;
+    }
+    aggregate(file.data(), file.size(), selectors);
+}
+
+void TraceSummary::aggregate(const char* data, size_t size, const std::vector<std::string>& selectors) {
+    const char* p = data;
+    const char* end = data + size;
+
+    // Header: map each CSV field index to a slot in columns, or -1
+    std::vector<int> slots;
+    const char* header_end = find_newline(p, end);
+    while (p <= header_end) {
+        const char* field_end = find_delimiter(p, header_end);
+        std::string name(p, field_end);
+        if (!name.empty() && name[name.size() - 1] == '\r') {
+            name.erase(name.size() - 1);
+        }
+        if (matches(name, selectors)) {
+            slots.push_back(static_cast<int>(columns.size()));
+            columns.push_back(ColumnStats());
+            columns.back().name = name;
+        } else {
+            slots.push_back(-1);
+        }
+        p = field_end + 1;
+    }
+
+    // Fields after the last selected one are skipped in a single memchr
+    size_t last_slot = 0;
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (slots[i] >= 0) last_slot = i + 1;
+    }
+    if (last_slot == 0) {
+        return;
+    }
+
+    p = header_end < end ? header_end + 1 : end;
+    while (p < end) {
+        const char* line_end = find_newline(p, end);
+        const char* field = p;
+        for (size_t i = 0; i < last_slot && field <= line_end; i++) {
+            const char* field_end = find_delimiter(field, line_end);
+            const char* value_end = field_end;
+            if (value_end > field && value_end[-1] == '\r') {
+                value_end--;
+            }
+
+            double value;
+            if (slots[i] >= 0 && value_end > field && parse_number(field, value_end, value)) {
+                ColumnStats& stats = columns[slots[i]];
+                if (stats.count == 0) {
+                    stats.first = stats.min = stats.max = value;
+                } else {
+                    if (value < stats.min) stats.min = value;
+                    if (value > stats.max) stats.max = value;
+                }
+                stats.last = value;
+                stats.sum += value;
+                stats.count++;
+            }
+            field = field_end + 1;
+        }
+        if (line_end > p) {
+            row_count++;
+        }
+        p = line_end + 1;
+    }
+}
+
+bool TraceSummary::ok() const {
+    return error_message.empty();
+}
+
+std::string TraceSummary::error() const {
+    return error_message;
+}
+
+long TraceSummary::rows() const {
+    return row_count;
+}
@@ -0,0 +1,45 @@
+// energibridge_trace.h
+#ifndef ENERGIBRIDGE_TRACE_H
+#define ENERGIBRIDGE_TRACE_H
+
+#include <string>
+#include <vector>
+
+// Running statistics of one CSV column
+struct ColumnStats {
+    std::string name;
+    long count;
+    double first;
+    double last;
+    double min;
+    double max;
+    double sum;
+
+    ColumnStats();
+    double mean() const;     // 0 when the column had no values
+    double delta() const;    // last - first, for cumulative counters
+};
+
+// Single-pass aggregation of an energibridge CSV. The file is mmapped and
+// only the selected columns are parsed; the rest of each row is skipped.
+// A selector is an exact column name or a prefix ending in '*'
+// ("CPU_USAGE_*", "CORE*"). ok() is false when the file cannot be read.
+class TraceSummary {
+public:
+    TraceSummary(const std::string& path, const std::vector<std::string>& selectors);
+
+    bool ok() const;
+    std::string error() const;
+    long rows() const;
+
+    // Matched columns in file order
+    std::vector<ColumnStats> columns;
+
+private:
+    std::string error_message;
+    long row_count;
+
+    void aggregate(const char* data, size_t size, const std::vector<std::string>& selectors);
+};
+
+#endif
@@ -0,0 +1,15 @@
+# setup.py for the native measurement trace tools
+from setuptools import setup, Extension
+
+trace_module = Extension(
+    '_trace_swig',
+    sources=['trace_swig.i', 'csv_scan.cpp', 'energibridge_trace.cpp', 'trace_archive.cpp'],
+    swig_opts=['-c++'],
+    extra_compile_args=['-O3', '-std=c++11'],
+)
+
+setup(
+    name='trace_swig',
+    ext_modules=[trace_module],
+    py_modules=['trace_swig'],
+)
@@ -0,0 +1,484 @@
+// trace_archive.cpp
+#include "trace_archive.h"
+#include "csv_scan.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits>
+#include <map>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char TRACE_MAGIC[8] = {'G', 'L', 'T', 'R', 'A', 'C', 'E', '\0'};
+static const uint32_t TRACE_VERSION = 1;
+
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t channel_count;
+    uint32_t run_count;
+    uint32_t reserved;
+    uint64_t names_offset;
+    uint64_t index_offset;
+};
+
+struct TraceIndexEntry {
+    int32_t run;
+    int32_t repetition;
+    uint32_t rows;
+    uint32_t reserved;
+    int64_t first_time_ms;
+    uint64_t offset;
+};
+
+static const double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+static size_t block_size(size_t channels, size_t rows) {
+    size_t bytes = channels * sizeof(double) + channels * rows * sizeof(float) + rows * sizeof(int32_t);
+    return (bytes + 7) & ~size_t(7);
+}
+
+// Splits the header line of a CSV, dropping a trailing '\r'
+static std::vector<std::string> csv_header(const char* p, const char* end, const char*& body) {
+    std::vector<std::string> fields;
+    const char* header_end = find_newline(p, end);
+    while (p <= header_end) {
+        const char* field_end = find_delimiter(p, header_end);
+        std::string name(p, field_end);
+        if (!name.empty() && name[name.size() - 1] == '\r') {
+            name.erase(name.size() - 1);
+        }
+        fields.push_back(name);
+        p = field_end + 1;
+    }
+    body = header_end < end ? header_end + 1 : end;
+    return fields;
+}
+
+struct RunSource {
+    int run;
+    int repetition;
+    std::string path;
+
+    bool operator<(const RunSource& other) const {
+        return run != other.run ? run < other.run : repetition < other.repetition;
+    }
+};
+
+// ------------------ CampaignPacker ------------------
+
+CampaignPacker::CampaignPacker(const std::string& experiment_dir)
+    : dir(experiment_dir), packed_runs(0) {}
+
+std::string CampaignPacker::error() const {
+    return error_message;
+}
+
+long CampaignPacker::runs() const {
+    return packed_runs;
+}
+
+bool CampaignPacker::write(const std::string& path) {
+    packed_runs = 0;
+    error_message.clear();
+
+    DIR* d = opendir(dir.c_str());
+    if (!d) {
+        error_message = dir + ": " + std::strerror(errno);
+        return false;
+    }
+    std::vector<RunSource> sources;
+    struct dirent* entry;
+    while ((entry = readdir(d)) != NULL) {
+        RunSource source;
+        int consumed = 0;
+        if (std::sscanf(entry->d_name, "run_%d_repetition_%d%n", &source.run, &source.repetition, &consumed) == 2
+                && entry->d_name[consumed] == '\0') {
+            source.path = dir + "/" + entry->d_name + "/energibridge.csv";
+            if (access(source.path.c_str(), R_OK) == 0) {
+                sources.push_back(source);
+            }
+        }
+    }
+    closedir(d);
+    std::sort(sources.begin(), sources.end());
+
+    // Channels are the union of all headers, in first-seen order
+    std::vector<std::string> channels;
+    std::map<std::string, int> channel_ids;
+    for (size_t i = 0; i < sources.size(); i++) {
+        MappedFile csv(sources[i].path);
+        if (!csv.ok()) {
+            continue;
+        }
+        const char* body;
+        std::vector<std::string> header = csv_header(csv.data(), csv.data() + csv.size(), body);
+        for (size_t c = 0; c < header.size(); c++) {
+            if (header[c] != "Time" && !header[c].empty() && !channel_ids.count(header[c])) {
+                channel_ids[header[c]] = static_cast<int>(channels.size());
+                channels.push_back(header[c]);
+            }
+        }
+    }
+
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) {
+        error_message = path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    TraceFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::fwrite(&header, sizeof(header), 1, out);
+    uint64_t offset = sizeof(header);
+
+    std::vector<TraceIndexEntry> index;
+    std::vector<char> block;
+    const size_t nch = channels.size();
+    for (size_t i = 0; i < sources.size(); i++) {
+        MappedFile csv(sources[i].path);
+        if (!csv.ok()) {
+            continue;
+        }
+        const char* end = csv.data() + csv.size();
+        const char* p;
+        std::vector<std::string> fields = csv_header(csv.data(), end, p);
+
+        // CSV field index -> channel, -2 for Time, -1 to skip
+        std::vector<int> slots(fields.size(), -1);
+        for (size_t c = 0; c < fields.size(); c++) {
+            if (fields[c] == "Time") {
+                slots[c] = -2;
+            } else if (channel_ids.count(fields[c])) {
+                slots[c] = channel_ids[fields[c]];
+            }
+        }
+
+        std::vector<std::vector<double> > values(nch);
+        std::vector<long long> times;
+        while (p < end) {
+            const char* line_end = find_newline(p, end);
+            if (line_end == p || (line_end == p + 1 && *p == '\r')) {
+                p = line_end + 1;
+                continue;
+            }
+            for (size_t c = 0; c < nch; c++) {
+                values[c].push_back(NOT_A_NUMBER);
+            }
+            times.push_back(times.empty() ? 0 : times.back());
+
+            const char* field = p;
+            for (size_t c = 0; c < fields.size() && field <= line_end; c++) {
+                const char* field_end = find_delimiter(field, line_end);
+                const char* value_end = field_end;
+                if (value_end > field && value_end[-1] == '\r') {
+                    value_end--;
+                }
+                double value;
+                if (slots[c] != -1 && value_end > field && parse_number(field, value_end, value)) {
+                    if (slots[c] == -2) {
+                        times.back() = static_cast<long long>(value);
+                    } else {
+                        values[slots[c]].back() = value;
+                    }
+                }
+                field = field_end + 1;
+            }
+            p = line_end + 1;
+        }
+
+        const size_t rows = times.size();
+        block.assign(block_size(nch, rows), 0);
+        double* bases = reinterpret_cast<double*>(&block[0]);
+        float* offsets = reinterpret_cast<float*>(&block[nch * sizeof(double)]);
+        int32_t* deltas = reinterpret_cast<int32_t*>(&block[nch * sizeof(double) + nch * rows * sizeof(float)]);
+
+        for (size_t c = 0; c < nch; c++) {
+            const std::vector<double>& column = values[c];
+            double base = 0.0;
+            for (size_t r = 0; r < rows; r++) {
+                if (!std::isnan(column[r])) {
+                    base = column[r];
+                    break;
+                }
+            }
+            bases[c] = base;
+            for (size_t r = 0; r < rows; r++) {
+                offsets[c * rows + r] = static_cast<float>(column[r] - base);
+            }
+        }
+        for (size_t r = 0; r < rows; r++) {
+            deltas[r] = static_cast<int32_t>(r == 0 ? 0 : times[r] - times[r - 1]);
+        }
+
+        if (!block.empty()) {
+            std::fwrite(&block[0], 1, block.size(), out);
+        }
+
+        TraceIndexEntry run;
+        std::memset(&run, 0, sizeof(run));
+        run.run = sources[i].run;
+        run.repetition = sources[i].repetition;
+        run.rows = static_cast<uint32_t>(rows);
+        run.first_time_ms = rows ? times[0] : 0;
+        run.offset = offset;
+        index.push_back(run);
+        offset += block.size();
+    }
+
+    header.names_offset = offset;
+    for (size_t c = 0; c < nch; c++) {
+        uint32_t length = static_cast<uint32_t>(channels[c].size());
+        std::fwrite(&length, sizeof(length), 1, out);
+        std::fwrite(channels[c].data(), 1, length, out);
+        offset += sizeof(length) + length;
+    }
+
+    // Keep the index 8-byte aligned
+    static const char padding[8] = {0};
+    size_t pad = (8 - offset % 8) % 8;
+    std::fwrite(padding, 1, pad, out);
+    offset += pad;
+
+    header.index_offset = offset;
+    if (!index.empty()) {
+        std::fwrite(&index[0], sizeof(TraceIndexEntry), index.size(), out);
+    }
+
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.channel_count = static_cast<uint32_t>(nch);
+    header.run_count = static_cast<uint32_t>(index.size());
+    std::fseek(out, 0, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1, out);
+
+    bool failed = std::ferror(out) != 0;
+    if (std::fclose(out) != 0 || failed) {
+        error_message = path + ": write failed";
+        return false;
+    }
+    packed_runs = static_cast<long>(index.size());
+    return true;
+}
+
+// ------------------ TraceArchive ------------------
+
+TraceArchive::TraceArchive(const std::string& path) : data(NULL), size(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_message = path + ": " + std::strerror(errno);
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TraceFileHeader)) {
+        error_message = path + ": not a trace archive";
+        close(fd);
+        return;
+    }
+    void* mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        error_message = path + ": " + std::strerror(errno);
+        return;
+    }
+    data = static_cast<const char*>(mapped);
+    size = static_cast<size_t>(st.st_size);
+
+    TraceFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 || header.version != TRACE_VERSION
+            || header.names_offset > size || header.index_offset > size
+            || (size - header.index_offset) / sizeof(TraceIndexEntry) < header.run_count) {
+        error_message = path + ": not a trace archive";
+        return;
+    }
+
+    const char* p = data + header.names_offset;
+    for (uint32_t c = 0; c < header.channel_count; c++) {
+        uint32_t length;
+        if (static_cast<size_t>(data + size - p) < sizeof(length)) {
+            error_message = path + ": truncated channel table";
+            return;
+        }
+        std::memcpy(&length, p, sizeof(length));
+        p += sizeof(length);
+        if (static_cast<size_t>(data + size - p) < length) {
+            error_message = path + ": truncated channel table";
+            return;
+        }
+        names.push_back(std::string(p, length));
+        p += length;
+    }
+}
+
+TraceArchive::~TraceArchive() {
+    if (data) {
+        munmap(const_cast<char*>(data), size);
+    }
+}
+
+bool TraceArchive::ok() const {
+    return error_message.empty();
+}
+
+std::string TraceArchive::error() const {
+    return error_message;
+}
+
+long TraceArchive::run_count() const {
+    if (!ok()) {
+        return 0;
+    }
+    TraceFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return header.run_count;
+}
+
+std::vector<std::string> TraceArchive::channel_names() const {
+    return names;
+}
+
+int TraceArchive::channel_index(const std::string& name) const {
+    for (size_t c = 0; c < names.size(); c++) {
+        if (names[c] == name) {
+            return static_cast<int>(c);
+        }
+    }
+    return -1;
+}
+
+static TraceIndexEntry index_entry(const char* data, int index) {
+    TraceFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    TraceIndexEntry entry;
+    std::memcpy(&entry, data + header.index_offset + index * sizeof(TraceIndexEntry), sizeof(entry));
+    return entry;
+}
+
+int TraceArchive::find_run(int run, int repetition) const {
+    long count = run_count();
+    for (long i = 0; i < count; i++) {
+        TraceIndexEntry entry = index_entry(data, static_cast<int>(i));
+        if (entry.run == run && entry.repetition == repetition) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+TraceRunInfo TraceArchive::run_info(int index) const {
+    TraceRunInfo info = {-1, -1, 0, 0};
+    if (index < 0 || index >= run_count()) {
+        return info;
+    }
+    TraceIndexEntry entry = index_entry(data, index);
+    info.run = entry.run;
+    info.repetition = entry.repetition;
+    info.rows = entry.rows;
+    info.first_time_ms = entry.first_time_ms;
+    return info;
+}
+
+const char* TraceArchive::run_block(int index, long& rows) const {
+    if (index < 0 || index >= run_count()) {
+        return NULL;
+    }
+    TraceIndexEntry entry = index_entry(data, index);
+    if (entry.offset > size || size - entry.offset < block_size(names.size(), entry.rows)) {
+        return NULL;
+    }
+    rows = entry.rows;
+    return data + entry.offset;
+}
+
+std::vector<long long> TraceArchive::timestamps(int index) const {
+    std::vector<long long> times;
+    long rows;
+    const char* block = run_block(index, rows);
+    if (!block) {
+        return times;
+    }
+    const size_t nch = names.size();
+    const int32_t* deltas = reinterpret_cast<const int32_t*>(block + nch * sizeof(double) + nch * rows * sizeof(float));
+    long long t = run_info(index).first_time_ms;
+    times.reserve(rows);
+    for (long r = 0; r < rows; r++) {
+        t += deltas[r];
+        times.push_back(t);
+    }
+    return times;
+}
+
+bool TraceArchive::channel_values(int index, int channel, std::vector<double>& values) const {
+    long rows;
+    const char* block = run_block(index, rows);
+    if (!block || channel < 0) {
+        return false;
+    }
+    double base;
+    std::memcpy(&base, block + channel * sizeof(double), sizeof(base));
+    const float* offsets = reinterpret_cast<const float*>(block + names.size() * sizeof(double)) + channel * rows;
+    values.resize(rows);
+    for (long r = 0; r < rows; r++) {
+        values[r] = base + offsets[r];
+    }
+    return true;
+}
+
+std::vector<double> TraceArchive::channel(int index, const std::string& name) const {
+    std::vector<double> values;
+    channel_values(index, channel_index(name), values);
+    return values;
+}
+
+std::vector<double> TraceArchive::channel_deltas(const std::string& name) const {
+    int c = channel_index(name);
+    long count = run_count();
+    std::vector<double> deltas(count, NOT_A_NUMBER);
+    for (long i = 0; i < count; i++) {
+        long rows;
+        const char* block = run_block(static_cast<int>(i), rows);
+        if (!block || c < 0) {
+            continue;
+        }
+        // Offsets are relative to the first value, so only the last one is needed
+        const float* offsets = reinterpret_cast<const float*>(block + names.size() * sizeof(double)) + c * rows;
+        long first = 0, last = rows - 1;
+        while (first <= last && std::isnan(offsets[first])) first++;
+        while (last >= first && std::isnan(offsets[last])) last--;
+        if (first <= last) {
+            deltas[i] = static_cast<double>(offsets[last]) - offsets[first];
+        }
+    }
+    return deltas;
+}
+
+std::vector<double> TraceArchive::channel_means(const std::string& name) const {
+    int c = channel_index(name);
+    long count = run_count();
+    std::vector<double> means(count, NOT_A_NUMBER);
+    std::vector<double> values;
+    for (long i = 0; i < count; i++) {
+        if (!channel_values(static_cast<int>(i), c, values)) {
+            continue;
+        }
+        double sum = 0.0;
+        long n = 0;
+        for (size_t r = 0; r < values.size(); r++) {
+            if (!std::isnan(values[r])) {
+                sum += values[r];
+                n++;
+            }
+        }
+        if (n > 0) {
+            means[i] = sum / n;
+        }
+    }
+    return means;
+}
@@ -0,0 +1,80 @@
+// trace_archive.h
+#ifndef TRACE_ARCHIVE_H
+#define TRACE_ARCHIVE_H
+
+#include <string>
+#include <vector>
+
+// Columnar binary archive of the energibridge.csv traces of one campaign.
+//
+// Layout (native byte order):
+//   header     magic "GLTRACE", version, channel/run counts, table offsets
+//   run blocks per run: double base[channels], float offset[channels][rows],
+//              int32 time_delta[rows]; each channel is stored as float32
+//              relative to its first value, so cumulative energy counters
+//              keep sub-millijoule resolution
+//   names      uint32 length + bytes per channel (all columns but Time)
+//   index      one entry per run: run, repetition, rows, first Time, offset
+// Channels missing from a run's CSV are NaN.
+
+struct TraceRunInfo {
+    int run;
+    int repetition;
+    long rows;
+    long long first_time_ms;
+};
+
+// Packs every run_<n>_repetition_<r>/energibridge.csv under an experiment
+// directory into one archive.
+class CampaignPacker {
+public:
+    explicit CampaignPacker(const std::string& experiment_dir);
+
+    bool write(const std::string& path);
+    std::string error() const;
+    long runs() const;
+
+private:
+    std::string dir;
+    std::string error_message;
+    long packed_runs;
+};
+
+// Read-only view of an archive. The file is mmapped once; run and channel
+// lookups only touch the requested columns.
+class TraceArchive {
+public:
+    explicit TraceArchive(const std::string& path);
+    ~TraceArchive();
+
+    TraceArchive(const TraceArchive&) = delete;
+    TraceArchive& operator=(const TraceArchive&) = delete;
+
+    bool ok() const;
+    std::string error() const;
+
+    long run_count() const;
+    std::vector<std::string> channel_names() const;
+    int channel_index(const std::string& name) const;      // -1 if absent
+    int find_run(int run, int repetition) const;           // -1 if absent
+    TraceRunInfo run_info(int index) const;
+
+    // One run
+    std::vector<long long> timestamps(int index) const;
+    std::vector<double> channel(int index, const std::string& name) const;
+
+    // One value per run, in index order (NaN where the channel is missing)
+    std::vector<double> channel_deltas(const std::string& name) const;
+    std::vector<double> channel_means(const std::string& name) const;
+
+private:
+    const char* data;
+    size_t size;
+    std::string error_message;
+    std::vector<std::string> names;
+
+    const char* run_block(int index, long& rows) const;
+    bool channel_values(int index, int channel, std::vector<double>& values) const;
+};
+
+#endif
@@ -0,0 +1,20 @@
+/* trace_swig.i */
+%module trace_swig
+
+%{
+#include "energibridge_trace.h"
+#include "trace_archive.h"
+%}
+
+%include "std_string.i"
+%include "std_vector.i"
+
+namespace std {
+    %template(StringVector) vector<string>;
+    %template(DoubleVector) vector<double>;
+    %template(LongLongVector) vector<long long>;
+    %template(ColumnStatsVector) vector<ColumnStats>;
+}
+
+%include "energibridge_trace.h"
+%include "trace_archive.h"
\ No newline at end of file
@@ -0,0 +1,21 @@
+/* move_result.i */
+// Hands large kernel results to Python without copying them.
+//
+// By default std_vector.i converts a returned container into a Python tuple
+// element by element. %move_result(TYPE, FUNCTION) instead move-constructs
+// the returned value into a heap object that the Python proxy owns
+// (SWIG_POINTER_OWN), so the buffer the kernel filled is the one Python
+// holds. The proxy indexes and slices like a sequence, list(result) copies it
+// out when needed, and passing it back into a kernel taking const TYPE&
+// converts nothing. TYPE must have a %template so the proxy class exists.
+
+%{
+#include <utility>
+%}
+
+%define %move_result(TYPE, FUNCTION)
+%typemap(out) TYPE FUNCTION {
+    $result = SWIG_NewPointerObj(new TYPE(std::move(static_cast<TYPE&>($1))),
+                                 $descriptor(TYPE *), SWIG_POINTER_OWN);
+}
+%enddef
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""
+Persistent Benchmark Worker
+---------------------------
+Long-lived process that keeps benchmark modules and their input data loaded
+and runs kernels on request, so a measurement window covers only the work
+instead of interpreter startup, imports and data generation.
+
+Usage:
+    python worker.py --socket /tmp/greenlab-worker.sock [--preload]
+
+Protocol (one JSON object per line over a Unix stream socket):
+    {"cmd": "ping"}
+    {"cmd": "load", "compiler": "swig", "benchmark": "bfs"}
+    {"cmd": "run", "compiler": "swig", "benchmark": "bfs", "trace_out": "/tmp/trace.json"}
+    {"cmd": "shutdown"}
+Every request gets one JSON line back with "ok" set to true or false.
+
+SWIG benchmarks run the WORKLOADS list of their main.py, with inputs that
+"load" generates for the next run only (send "load" before every "run" to
+keep generation out of the measured request). For other compilers "load"
+imports the script once, so its extension modules stay in sys.modules, and
+"run" executes its __main__ block in-process: that saves interpreter startup
+and module imports but regenerates their data on every run.
+
+"trace_out" (optional, sent by worker_client.py when KERNEL_TRACE_OUT is set)
+traces that one SWIG run and writes its spans there, as a standalone run does;
+input generation happened in "load" and is not part of it.
+"""
+import argparse
+import importlib.util
+import json
+import os
+import runpy
+import socket
+import sys
+import time
+from contextlib import contextmanager
+from pathlib import Path
+
+RUNNER_DIR = Path(os.path.dirname(os.path.abspath(__file__)))
+
+COMPILERS = ["pure_python", "cython", "swig"]
+BENCHMARKS = ["bfs", "convex", "dense_matrix", "fft", "json_bench", "k_means", "quick_sort", "regex", "sieve", "nbody"]
+
+
+def script_path(compiler, benchmark):
+    """Same layout RunnerConfig uses to launch the scripts."""
+    if compiler == "pure_python":
+        return RUNNER_DIR / compiler / f"{benchmark}.py"
+    return RUNNER_DIR / compiler / benchmark / "main.py"
+
+
+def load_script(compiler, benchmark):
+    """Import a benchmark script as a module without running its __main__ block."""
+    path = script_path(compiler, benchmark)
+    if str(path.parent) not in sys.path:
+        sys.path.insert(0, str(path.parent))
+    spec = importlib.util.spec_from_file_location(f"{compiler}_{benchmark}_main", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+# ------------------ SWIG workloads ------------------
+# Every SWIG main.py lists its tests as WORKLOADS, (prepare, benchmark, args)
+# tuples its own __main__ block also runs. prepare(*args) generates the inputs
+# and runs the warm-up; benchmark(*args, inputs=...) makes the timed kernel
+# calls under main.py's latency labels. Inputs are used by one run only: the
+# kernels may update them in place (nbody steps its bodies), so the next
+# "load" prepares a fresh set.
+
+def prepare_workloads(module):
+    return [prepare(*args) for prepare, _, args in module.WORKLOADS]
+
+
+def run_workloads(module, inputs):
+    for (_, benchmark, args), prepared in zip(module.WORKLOADS, inputs):
+        benchmark(*args, inputs=prepared)
+
+
+@contextmanager
+def traced(trace_out):
+    """Trace one SWIG run into trace_out, the file KERNEL_TRACE_OUT names for it.
+
+    KernelMetrics turns tracing on when it is created with KERNEL_TRACE_OUT
+    set, so the variable is set for this run only; the rings are emptied first
+    so the file holds this run's spans alone.
+    """
+    kernel_metrics = sys.modules.get("kernel_metrics")
+    instrument = kernel_metrics.instrument_swig if kernel_metrics else None
+    if not trace_out or instrument is None:
+        yield
+        return
+    instrument.trace_clear()
+    os.environ[kernel_metrics.TRACE_ENV] = trace_out
+    try:
+        yield
+    finally:
+        del os.environ[kernel_metrics.TRACE_ENV]
+        instrument.trace_enable(False)
+        instrument.trace_write_json(trace_out)
+
+
+# ------------------ Worker ------------------
+
+class BenchmarkWorker:
+    def __init__(self):
+        self.loaded = {}    # (compiler, benchmark) -> (module, inputs for the next run)
+
+    def load(self, compiler, benchmark):
+        """Import the benchmark and, for SWIG, prepare the inputs of the next run."""
+        key = (compiler, benchmark)
+        if compiler not in COMPILERS or benchmark not in BENCHMARKS:
+            raise ValueError(f"Unknown benchmark {compiler}/{benchmark}")
+        module, inputs = self.loaded.get(key, (None, None))
+        if inputs is not None or (key in self.loaded and compiler != "swig"):
+            return False
+
+        if module is None:
+            module = load_script(compiler, benchmark)
+        if compiler == "swig":
+            self.loaded[key] = (module, prepare_workloads(module))
+        else:
+            # Only the import is kept: run() executes the __main__ block, whose
+            # imports then come from sys.modules
+            self.loaded[key] = (module, None)
+        return True
+
+    def run(self, compiler, benchmark, trace_out=None):
+        key = (compiler, benchmark)
+        self.load(compiler, benchmark)
+        module, inputs = self.loaded[key]
+        if compiler == "swig":
+            self.loaded[key] = (module, None)
+
+        start = time.perf_counter()
+        if compiler == "swig":
+            # Fresh metrics so each request reports only its own kernel calls
+            with traced(trace_out):
+                module.metrics = module.KernelMetrics()
+                run_workloads(module, inputs)
+            metrics = module.metrics.as_dict()
+        else:
+            path = script_path(compiler, benchmark)
+            if str(path.parent) not in sys.path:
+                sys.path.insert(0, str(path.parent))
+            sys.argv = [str(path)]
+            runpy.run_path(str(path), run_name="__main__")
+            metrics = {}
+        elapsed = time.perf_counter() - start
+
+        return {"elapsed_s": elapsed, "metrics": metrics}
+
+    def handle(self, request):
+        cmd = request.get("cmd")
+        if cmd == "ping":
+            return {"ok": True, "pid": os.getpid()}
+        if cmd == "load":
+            loaded = self.load(request["compiler"], request["benchmark"])
+            return {"ok": True, "loaded": loaded}
+        if cmd == "run":
+            result = self.run(request["compiler"], request["benchmark"], request.get("trace_out"))
+            return dict(result, ok=True)
+        raise ValueError(f"Unknown command: {cmd}")
+
+
+def serve(socket_path, worker):
+    if os.path.exists(socket_path):
+        os.unlink(socket_path)
+
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(socket_path)
+    server.listen(1)
+    print(f"Benchmark worker {os.getpid()} listening on {socket_path}", flush=True)
+
+    try:
+        while True:
+            conn, _ = server.accept()
+            with conn, conn.makefile("rw") as stream:
+                for line in stream:
+                    if not line.strip():
+                        continue
+                    try:
+                        request = json.loads(line)
+                        if request.get("cmd") == "shutdown":
+                            stream.write(json.dumps({"ok": True}) + "\n")
+                            stream.flush()
+                            return
+                        response = worker.handle(request)
+                    except Exception as e:
+                        response = {"ok": False, "error": f"{type(e).__name__}: {e}"}
+                    stream.write(json.dumps(response) + "\n")
+                    stream.flush()
+    finally:
+        server.close()
+        os.unlink(socket_path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Persistent benchmark worker.")
+    parser.add_argument("--socket", "-s", type=str, default="/tmp/greenlab-worker.sock", help="Unix socket path")
+    parser.add_argument("--preload", action="store_true", help="Load every SWIG benchmark before serving")
+    args = parser.parse_args()
+
+    worker = BenchmarkWorker()
+    if args.preload:
+        for benchmark in BENCHMARKS:
+            worker.load("swig", benchmark)
+
+    serve(args.socket, worker)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+Client for the persistent benchmark worker (worker.py).
+
+Sends one command and prints the JSON reply. Kept free of heavy imports so
+that, when launched under energibridge, almost all of the measured time is
+spent in the worker running the kernel.
+
+Usage:
+    python -S worker_client.py [--socket PATH] run swig bfs
+    python -S worker_client.py [--socket PATH] load swig bfs
+    python -S worker_client.py [--socket PATH] ping|shutdown
+"""
+import json
+import os
+import socket
+import sys
+
+METRICS_ENV = "KERNEL_METRICS_OUT"
+TRACE_ENV = "KERNEL_TRACE_OUT"
+
+
+def send(socket_path, request, timeout=None):
+    """Send one request to the worker and return its decoded reply."""
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+        sock.settimeout(timeout)
+        sock.connect(socket_path)
+        sock.sendall((json.dumps(request) + "\n").encode())
+        reply = b""
+        while not reply.endswith(b"\n"):
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            reply += chunk
+    return json.loads(reply)
+
+
+def main(argv):
+    socket_path = "/tmp/greenlab-worker.sock"
+    if len(argv) >= 2 and argv[0] == "--socket":
+        socket_path = argv[1]
+        argv = argv[2:]
+
+    if not argv or argv[0] not in ("ping", "load", "run", "shutdown"):
+        print(__doc__, file=sys.stderr)
+        return 2
+
+    request = {"cmd": argv[0]}
+    if argv[0] in ("load", "run"):
+        if len(argv) != 3:
+            print(__doc__, file=sys.stderr)
+            return 2
+        request["compiler"], request["benchmark"] = argv[1], argv[2]
+    if argv[0] == "run" and os.environ.get(TRACE_ENV):
+        # The worker writes the trace itself, since the spans are in its rings
+        request["trace_out"] = os.environ[TRACE_ENV]
+
+    reply = send(socket_path, request)
+    print(json.dumps(reply))
+
+    # Same hand-off as the standalone scripts, so RunnerConfig reads it unchanged
+    metrics_path = os.environ.get(METRICS_ENV)
+    if metrics_path and reply.get("metrics"):
+        with open(metrics_path, "w") as f:
+            json.dump(reply["metrics"], f, indent=2)
+
+    return 0 if reply.get("ok") else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))